@@ -5,6 +5,15 @@ using namespace std;
 // Technique: Kruskal's Algorithm + Union-Find (Disjoint Set Union)
 // Input: n nodes, m edges, followed by m lines (u v w)
 // Output: Minimum total cost + edges selected
+//
+// Usage: ./a.out                   Kruskal (full sort)
+//        ./a.out filter [threads]  Filter-Kruskal: partition around pivots, drop intra-component edges early
+//        ./a.out boruvka [threads] parallel Boruvka over a lock-free union-find
+//        ./a.out bench [n m]       engine scaling on a random geometric graph (default 1M nodes, 50M edges)
+//        ./a.out points [k]        input is n, then n lines "x y"; exact MST seeded with each node's k nearest neighbours
+//        ./a.out geo-bench [n k]   k-NN-seeded MST vs complete graph (default 1M points, k = 10)
+// Build with -pthread. Equal weights are ordered by input position, so every mode selects
+// the same edges and prints them in the same order.
 
 struct DSU {
     vector<int> parent, rank;
@@ -17,6 +26,11 @@ struct DSU {
         if(parent[x] != x) parent[x] = find(parent[x]);
         return parent[x];
     }
+    // Root of x without path compression, safe for many threads while nobody unites
+    int root(int x) const {
+        while(parent[x] != x) x = parent[x];
+        return x;
+    }
     void unite(int a, int b) {
         a = find(a);
         b = find(b);
@@ -28,10 +42,684 @@ struct DSU {
     }
 };
 
-int main() {
+// Union-find shared by all Boruvka threads. find halves paths with CAS, and unite links the
+// root with the larger index under the other one, so concurrent links can never form a cycle.
+class ConcurrentDSU {
+    unique_ptr<atomic<int>[]> parent;
+public:
+    ConcurrentDSU(int n) : parent(new atomic<int>[n+1]) {
+        for(int i = 0; i <= n; i++) parent[i].store(i, memory_order_relaxed);
+    }
+    int find(int x) {
+        while(true) {
+            int p = parent[x].load(memory_order_relaxed);
+            if(p == x) return x;
+            int gp = parent[p].load(memory_order_relaxed);
+            if(p != gp) parent[x].compare_exchange_weak(p, gp, memory_order_relaxed);
+            x = gp;
+        }
+    }
+    bool unite(int a, int b) {
+        while(true) {
+            a = find(a);
+            b = find(b);
+            if(a == b) return false;
+            if(a < b) swap(a, b);
+            int expected = a;
+            if(parent[a].compare_exchange_strong(expected, b)) return true;
+        }
+    }
+};
+
+// Edge plus its input position; (w, id) orders all edges strictly.
+struct MstEdge {
+    int u, v, w, id;
+};
+
+inline uint64_t edgeKey(const MstEdge& e) {
+    return (uint64_t)((uint32_t)e.w ^ 0x80000000u) << 32 | (uint32_t)e.id;
+}
+
+inline bool keyLess(const MstEdge& a, const MstEdge& b) {
+    return edgeKey(a) < edgeKey(b);
+}
+
+vector<MstEdge> indexEdges(const vector<array<int,3>>& edges) {
+    vector<MstEdge> indexed(edges.size());
+    for(size_t i = 0; i < edges.size(); i++)
+        indexed[i] = {edges[i][0], edges[i][1], edges[i][2], (int)i};
+    return indexed;
+}
+
+// Runs fn(t) for t = 0 .. threads-1, each on its own thread.
+template<class Fn>
+void parallelFor(int threads, Fn fn) {
+    vector<thread> pool;
+    for(int t = 1; t < threads; t++) pool.emplace_back(fn, t);
+    fn(0);
+    for(auto &worker : pool) worker.join();
+}
+
+// Moves the edges of e[lo, hi) that satisfy keep() to the front and returns where they end.
+// The rest follow, or are discarded when dropRest is set. Large ranges are split between
+// threads: each counts its slice, then scatters it through 'scratch'.
+template<class Pred>
+size_t splitEdges(vector<MstEdge>& e, size_t lo, size_t hi, Pred keep, bool dropRest,
+                  int threads, vector<MstEdge>& scratch) {
+    size_t len = hi - lo;
+    threads = max(1, min(threads, (int)(len / 65536)));
+    if(threads == 1) {
+        if(dropRest) return remove_if(e.begin() + lo, e.begin() + hi, [&](const MstEdge& x) { return !keep(x); }) - e.begin();
+        return partition(e.begin() + lo, e.begin() + hi, keep) - e.begin();
+    }
+    vector<size_t> kept(threads + 1, 0), rest(threads + 1, 0);
+    auto slice = [&](int t) { return lo + len * t / threads; };
+    parallelFor(threads, [&](int t) {
+        for(size_t i = slice(t); i < slice(t + 1); i++) kept[t + 1] += keep(e[i]);
+        rest[t + 1] = slice(t + 1) - slice(t) - kept[t + 1];
+    });
+    for(int t = 0; t < threads; t++) kept[t + 1] += kept[t];
+    rest[0] = kept[threads];
+    for(int t = 0; t < threads; t++) rest[t + 1] += rest[t];
+    size_t end = dropRest ? kept[threads] : len;
+    parallelFor(threads, [&](int t) {
+        size_t k = lo + kept[t], r = lo + rest[t];
+        for(size_t i = slice(t); i < slice(t + 1); i++) {
+            if(keep(e[i])) scratch[k++] = e[i];
+            else if(!dropRest) scratch[r++] = e[i];
+        }
+    });
+    parallelFor(threads, [&](int t) {
+        copy(scratch.begin() + lo + end * t / threads, scratch.begin() + lo + end * (t + 1) / threads,
+             e.begin() + lo + end * t / threads);
+    });
+    return lo + kept[threads];
+}
+
+// Plain Kruskal: sort everything, then scan.
+vector<array<int,3>> kruskalMst(int n, const vector<array<int,3>>& edges) {
+    vector<MstEdge> sorted = indexEdges(edges);
+    sort(sorted.begin(), sorted.end(), keyLess);
+
+    DSU dsu(n);
+    vector<array<int,3>> mst_edges;
+    for(auto &e : sorted) {
+        if(dsu.find(e.u) != dsu.find(e.v)) {
+            dsu.unite(e.u, e.v);
+            mst_edges.push_back({e.u, e.v, e.w});
+        }
+    }
+    return mst_edges;
+}
+
+// --- Filter-Kruskal ---
+// Edges are split around a pivot; the light half is solved first, then the heavy half is
+// filtered against the components built so far before it is touched again. In dense
+// candidate graphs most heavy edges end up inside a component and are never sorted.
+class FilterKruskal {
+    static const size_t BASE_CASE = 1 << 14;
+    int n, threads;
+    DSU dsu;
+    vector<MstEdge> scratch;
+    mt19937 rng{7};
+    vector<array<int,3>> mst_edges;
+
+    void kruskalBase(vector<MstEdge>& e, size_t lo, size_t hi) {
+        sort(e.begin() + lo, e.begin() + hi, keyLess);
+        for(size_t i = lo; i < hi && (int)mst_edges.size() < n - 1; i++) {
+            if(dsu.find(e[i].u) != dsu.find(e[i].v)) {
+                dsu.unite(e[i].u, e[i].v);
+                mst_edges.push_back({e[i].u, e[i].v, e[i].w});
+            }
+        }
+    }
+
+    // Median of three random keys from e[lo, hi).
+    uint64_t pickPivot(const vector<MstEdge>& e, size_t lo, size_t hi) {
+        uniform_int_distribution<size_t> pick(lo, hi - 1);
+        uint64_t a = edgeKey(e[pick(rng)]), b = edgeKey(e[pick(rng)]), c = edgeKey(e[pick(rng)]);
+        return max(min(a, b), min(max(a, b), c));
+    }
+
+    void solve(vector<MstEdge>& e, size_t lo, size_t hi) {
+        if(hi - lo <= BASE_CASE) {
+            kruskalBase(e, lo, hi);
+            return;
+        }
+        uint64_t pivot = pickPivot(e, lo, hi);
+        size_t mid = splitEdges(e, lo, hi, [&](const MstEdge& x) { return edgeKey(x) <= pivot; },
+                                false, threads, scratch);
+        if(mid == hi) {             // Pivot was the heaviest edge: nothing to split off
+            kruskalBase(e, lo, hi);
+            return;
+        }
+        solve(e, lo, mid);
+        if((int)mst_edges.size() == n - 1) return;
+        size_t end = splitEdges(e, mid, hi, [&](const MstEdge& x) { return dsu.root(x.u) != dsu.root(x.v); },
+                                true, threads, scratch);
+        solve(e, mid, end);
+    }
+
+public:
+    FilterKruskal(int n, int threads) : n(n), threads(threads), dsu(n) {}
+
+    vector<array<int,3>> run(const vector<array<int,3>>& edges) {
+        vector<MstEdge> work = indexEdges(edges);
+        scratch.resize(work.size());
+        solve(work, 0, work.size());
+        return mst_edges;
+    }
+};
+
+vector<array<int,3>> filterKruskalMst(int n, const vector<array<int,3>>& edges, int threads) {
+    return FilterKruskal(n, threads).run(edges);
+}
+
+// --- Parallel Boruvka ---
+// Every round, each component picks its lightest outgoing edge (an atomic min on the
+// packed (w, id) key) and all picks are united at once through the lock-free union-find.
+// Edges inside a component are dropped between rounds, so later rounds get cheaper.
+vector<array<int,3>> boruvkaMst(int n, const vector<array<int,3>>& edges, int threads) {
+    const uint64_t NONE = UINT64_MAX;
+    ConcurrentDSU dsu(n);
+    unique_ptr<atomic<uint64_t>[]> best(new atomic<uint64_t>[n+1]);
+    for(int i = 0; i <= n; i++) best[i].store(NONE, memory_order_relaxed);
+    vector<MstEdge> work = indexEdges(edges), scratch(work.size());
+    vector<vector<int>> picked(threads);
+
+    auto lowerTo = [&](int r, uint64_t key) {
+        uint64_t cur = best[r].load(memory_order_relaxed);
+        while(key < cur && !best[r].compare_exchange_weak(cur, key, memory_order_relaxed)) {}
+    };
+
+    size_t live = work.size();
+    while(live > 0) {
+        // 1. Lightest outgoing edge of every component
+        parallelFor(threads, [&](int t) {
+            for(size_t i = live * t / threads; i < live * (t + 1) / threads; i++) {
+                int ru = dsu.find(work[i].u), rv = dsu.find(work[i].v);
+                if(ru == rv) continue;
+                uint64_t key = edgeKey(work[i]);
+                lowerTo(ru, key);
+                lowerTo(rv, key);
+            }
+        });
+        // 2. Unite along every pick; an edge picked from both sides is only added once
+        atomic<int> merged{0};
+        parallelFor(threads, [&](int t) {
+            int count = 0;
+            for(int r = 1 + (long long)n * t / threads; r <= (long long)n * (t + 1) / threads; r++) {
+                uint64_t key = best[r].load(memory_order_relaxed);
+                if(key == NONE) continue;
+                best[r].store(NONE, memory_order_relaxed);
+                int id = (int)(uint32_t)key;
+                if(dsu.unite(edges[id][0], edges[id][1])) {
+                    picked[t].push_back(id);
+                    count++;
+                }
+            }
+            merged += count;
+        });
+        if(merged == 0) break;
+        // 3. Drop edges that now lie inside one component
+        live = splitEdges(work, 0, live, [&](const MstEdge& x) { return dsu.find(x.u) != dsu.find(x.v); },
+                          true, threads, scratch);
+    }
+
+    vector<MstEdge> chosen;
+    for(auto &ids : picked)
+        for(int id : ids) chosen.push_back({edges[id][0], edges[id][1], edges[id][2], id});
+    sort(chosen.begin(), chosen.end(), keyLess);
+    vector<array<int,3>> mst_edges;
+    for(auto &e : chosen) mst_edges.push_back({e.u, e.v, e.w});
+    return mst_edges;
+}
+
+long long totalCost(const vector<array<int,3>>& mst_edges) {
+    long long cost = 0;
+    for(auto &e : mst_edges) cost += e[2];
+    return cost;
+}
+
+double msSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+// --- Coordinate-only input ---
+// When only node positions are known, the complete graph has n(n-1)/2 candidate cables.
+// Instead every node's k nearest neighbours (found with a k-d tree) seed a geometric Boruvka
+// that finds the exact Euclidean MST. Cable cost is the straight-line
+// distance rounded to whole units (e.g. metres).
+struct Point {
+    double x, y;
+};
+
+inline double dist2(const Point& a, const Point& b) {
+    double dx = a.x - b.x, dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+inline int cableCost(const Point& a, const Point& b) {
+    return (int)llround(sqrt(dist2(a, b)));
+}
+
+// Implicit k-d tree: a permutation of node IDs where each range [lo, hi) is split at its
+// middle element, alternating x and y with depth.
+class KdTree {
+public:
+    // Per-subtree summary for nearestOutside: the label shared by every node of the subtree
+    // (-1 if it holds several) and its bounding box.
+    struct Subtree {
+        int label;
+        Point lo, hi;
+    };
+
+private:
+    static const int LEAF = 8;
+    const vector<Point>& pts;
+    vector<int> order;
+
+    static double coord(const Point& p, int dim) { return dim ? p.y : p.x; }
+
+    void build(int lo, int hi, int dim) {
+        if(hi - lo <= LEAF) return;
+        int mid = (lo + hi) / 2;
+        nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+                    [&](int a, int b) { return coord(pts[a], dim) < coord(pts[b], dim); });
+        build(lo, mid, dim ^ 1);
+        build(mid + 1, hi, dim ^ 1);
+    }
+
+    // Visits candidates nearest-first by subtree; accept(j, d2) returns the current pruning radius².
+    template<class Accept>
+    void search(int lo, int hi, int dim, const Point& q, double& radius2, Accept& accept) const {
+        if(hi - lo <= LEAF) {
+            for(int i = lo; i < hi; i++) radius2 = accept(order[i], dist2(q, pts[order[i]]));
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        radius2 = accept(order[mid], dist2(q, pts[order[mid]]));
+        double diff = coord(q, dim) - coord(pts[order[mid]], dim);
+        if(diff < 0) {
+            search(lo, mid, dim ^ 1, q, radius2, accept);
+            if(diff * diff < radius2) search(mid + 1, hi, dim ^ 1, q, radius2, accept);
+        } else {
+            search(mid + 1, hi, dim ^ 1, q, radius2, accept);
+            if(diff * diff < radius2) search(lo, mid, dim ^ 1, q, radius2, accept);
+        }
+    }
+
+    static int tagAt(int lo, int hi) { return hi - lo <= LEAF ? lo : (lo + hi) / 2; }
+
+    // Fills tag[tagAt(lo, hi)] for the subtree [lo, hi) and its descendants; returns false if
+    // the range is empty.
+    bool tagRange(int lo, int hi, const vector<int>& label, vector<Subtree>& tag) const {
+        if(lo >= hi) return false;
+        Subtree t;
+        int first = order[tagAt(lo, hi)];
+        t.label = label[first];
+        t.lo = t.hi = pts[first];
+        auto add = [&](const Subtree& c) {
+            if(c.label != t.label) t.label = -1;
+            t.lo = {min(t.lo.x, c.lo.x), min(t.lo.y, c.lo.y)};
+            t.hi = {max(t.hi.x, c.hi.x), max(t.hi.y, c.hi.y)};
+        };
+        if(hi - lo <= LEAF) {
+            for(int p = lo + 1; p < hi; p++) add({label[order[p]], pts[order[p]], pts[order[p]]});
+        } else {
+            int mid = (lo + hi) / 2;
+            if(tagRange(lo, mid, label, tag)) add(tag[tagAt(lo, mid)]);
+            if(tagRange(mid + 1, hi, label, tag)) add(tag[tagAt(mid + 1, hi)]);
+        }
+        tag[tagAt(lo, hi)] = t;
+        return true;
+    }
+
+    void searchOutside(int lo, int hi, int dim, int i, const vector<int>& label, const vector<Subtree>& tag,
+                       double& radius2, int& best) const {
+        if(lo >= hi) return;
+        const Subtree& t = tag[tagAt(lo, hi)];
+        const Point& q = pts[i];
+        double dx = max({0.0, t.lo.x - q.x, q.x - t.hi.x}), dy = max({0.0, t.lo.y - q.y, q.y - t.hi.y});
+        if(t.label == label[i] || dx * dx + dy * dy >= radius2) return;
+        auto consider = [&](int j) {
+            double d2 = dist2(q, pts[j]);
+            if(label[j] != label[i] && d2 < radius2) {
+                radius2 = d2;
+                best = j;
+            }
+        };
+        if(hi - lo <= LEAF) {
+            for(int p = lo; p < hi; p++) consider(order[p]);
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        consider(order[mid]);
+        double diff = coord(q, dim) - coord(pts[order[mid]], dim);
+        if(diff < 0) {
+            searchOutside(lo, mid, dim ^ 1, i, label, tag, radius2, best);
+            if(diff * diff < radius2) searchOutside(mid + 1, hi, dim ^ 1, i, label, tag, radius2, best);
+        } else {
+            searchOutside(mid + 1, hi, dim ^ 1, i, label, tag, radius2, best);
+            if(diff * diff < radius2) searchOutside(lo, mid, dim ^ 1, i, label, tag, radius2, best);
+        }
+    }
+
+public:
+    // pts is 1-based; pts[0] is unused.
+    KdTree(const vector<Point>& pts) : pts(pts), order(pts.size() - 1) {
+        iota(order.begin(), order.end(), 1);
+        build(0, order.size(), 0);
+    }
+
+    // Node IDs in tree order; neighbouring entries are close in space.
+    const vector<int>& nodes() const { return order; }
+
+    // The k nearest nodes to node i (excluding i), nearest first.
+    void nearest(int i, int k, vector<pair<double,int>>& out) const {
+        out.clear();
+        double radius2 = numeric_limits<double>::infinity();
+        auto accept = [&](int j, double d2) {
+            if(j != i && ((int)out.size() < k || d2 < out.back().first)) {
+                if((int)out.size() == k) out.pop_back();
+                out.insert(upper_bound(out.begin(), out.end(), make_pair(d2, j)), {d2, j});
+            }
+            return (int)out.size() == k ? out.back().first : radius2;
+        };
+        search(0, order.size(), 0, pts[i], radius2, accept);
+    }
+
+    // One Subtree per position: a subtree is tagged at its middle position, a leaf range at
+    // its first one (no two subtrees share that position).
+    vector<Subtree> subtreeTags(const vector<int>& label) const {
+        vector<Subtree> tag(order.size());
+        tagRange(0, order.size(), label, tag);
+        return tag;
+    }
+
+    // Nearest node to node i whose label differs from label[i], if it is closer than
+    // sqrt(radius2); then radius2 is lowered to its squared distance. Returns 0 otherwise.
+    // Subtrees tagged with i's own label or lying beyond the radius are skipped, so a search
+    // does not walk its whole component before reaching another one.
+    int nearestOutside(int i, const vector<int>& label, const vector<Subtree>& tag, double& radius2) const {
+        int best = 0;
+        searchOutside(0, order.size(), 0, i, label, tag, radius2, best);
+        return best;
+    }
+};
+
+// Candidate cables from every node to its k nearest neighbours.
+vector<array<int,3>> knnCandidateGraph(const vector<Point>& pts, const KdTree& tree, int k, int threads) {
+    int n = pts.size() - 1;
+    vector<array<int,3>> edges((size_t)n * k);
+    vector<int> found(n + 1, 0);
+    parallelFor(threads, [&](int t) {
+        vector<pair<double,int>> near;
+        // Queries run in tree order so consecutive searches touch the same parts of the tree.
+        for(int p = (long long)n * t / threads; p < (long long)n * (t + 1) / threads; p++) {
+            int i = tree.nodes()[p];
+            tree.nearest(i, k, near);
+            found[i] = near.size();
+            for(int j = 0; j < (int)near.size(); j++)
+                edges[(size_t)(i - 1) * k + j] = {i, near[j].second, cableCost(pts[i], pts[near[j].second])};
+        }
+    });
+    size_t out = 0;   // Close the gaps left when n <= k
+    for(int i = 1; i <= n; i++)
+        for(int j = 0; j < found[i]; j++) edges[out++] = edges[(size_t)(i - 1) * k + j];
+    edges.resize(out);
+    return edges;
+}
+
+// Exact MST by geometric Boruvka, with the k-NN graph as a head start (on its own that graph
+// can miss MST cables, e.g. between clusters). Each round every piece adds a cable to its
+// nearest outside node. If one of a node's k nearest neighbours lies outside its piece, the
+// nearest outside node is among them, so the k-NN graph alone seeds each piece's best cable.
+// Only the other nodes search, and only if their k-th neighbour is closer than that cable;
+// k-d subtrees lying entirely inside the piece, or farther away than the cable, are skipped.
+vector<array<int,3>> geometricMst(const vector<Point>& pts, int k, int threads) {
+    int n = pts.size() - 1;
+    KdTree tree(pts);
+    vector<array<int,3>> candidates = knnCandidateGraph(pts, tree, k, threads);
+    vector<double> kth2(n + 1, 0), candD2(candidates.size());  // Squared lengths
+    for(size_t e = 0; e < candidates.size(); e++) {
+        candD2[e] = dist2(pts[candidates[e][0]], pts[candidates[e][1]]);
+        kth2[candidates[e][0]] = max(kth2[candidates[e][0]], candD2[e]);
+    }
+
+    DSU dsu(n);
+    vector<array<int,3>> mst_edges;
+    vector<int> label(n + 1);
+    vector<char> boundary(n + 1);
+    while((int)mst_edges.size() < n - 1) {
+        for(int i = 1; i <= n; i++) label[i] = dsu.find(i);
+        vector<double> bestD2(n + 1, numeric_limits<double>::infinity());
+        vector<array<int,3>> bridge(n + 1, {0, 0, 0});
+        fill(boundary.begin(), boundary.end(), 0);
+        size_t kept = 0;  // Cables inside a piece stay inside it, so they are dropped for good
+        for(size_t e = 0; e < candidates.size(); e++) {
+            int c = label[candidates[e][0]];
+            if(c == label[candidates[e][1]]) continue;
+            boundary[candidates[e][0]] = 1;
+            if(candD2[e] < bestD2[c]) {
+                bestD2[c] = candD2[e];
+                bridge[c] = candidates[e];
+            }
+            candD2[kept] = candD2[e];
+            candidates[kept++] = candidates[e];
+        }
+        candidates.resize(kept);
+        candD2.resize(kept);
+
+        vector<KdTree::Subtree> tag;
+        for(int i : tree.nodes()) {  // Tree order: consecutive searches share the same subtrees
+            int c = label[i];
+            if(boundary[i] || kth2[i] >= bestD2[c]) continue;
+            if(tag.empty()) tag = tree.subtreeTags(label);
+            int j = tree.nearestOutside(i, label, tag, bestD2[c]);
+            if(j) bridge[c] = {i, j, cableCost(pts[i], pts[j])};
+        }
+
+        vector<pair<double,int>> byLength;  // Shortest first, so equal-cost cycles keep the MST
+        for(int c = 1; c <= n; c++)
+            if(bridge[c][0]) byLength.push_back({bestD2[c], c});
+        sort(byLength.begin(), byLength.end());
+        for(auto [d2, c] : byLength) {
+            auto &b = bridge[c];
+            if(dsu.find(b[0]) != dsu.find(b[1])) {
+                dsu.unite(b[0], b[1]);
+                mst_edges.push_back(b);
+            }
+        }
+    }
+    return kruskalMst(n, mst_edges);  // Same cable order as the other modes
+}
+
+// Every pair of nodes as a candidate cable.
+vector<array<int,3>> completeGraph(const vector<Point>& pts) {
+    int n = pts.size() - 1;
+    vector<array<int,3>> edges;
+    edges.reserve((size_t)n * (n - 1) / 2);
+    for(int i = 1; i <= n; i++)
+        for(int j = i + 1; j <= n; j++) edges.push_back({i, j, cableCost(pts[i], pts[j])});
+    return edges;
+}
+
+// n random points in the unit square; every pair closer than r is a candidate cable, with r
+// chosen so that about m pairs qualify. Weight is the length, scaled so r is 1,000,000.
+void buildGeometricGraph(int n, long long m, mt19937& rng, vector<array<int,3>>& edges) {
+    uniform_real_distribution<double> coord(0.0, 1.0);
+    vector<double> x(n + 1), y(n + 1);
+    for(int i = 1; i <= n; i++) x[i] = coord(rng), y[i] = coord(rng);
+
+    double r = sqrt(2.0 * m / (M_PI * n * (n - 1.0)));
+    int grid = max(1, min((int)(1.0 / r), 1 << 14));
+    auto cellOf = [&](int i) {
+        return min(grid - 1, (int)(x[i] * grid)) * grid + min(grid - 1, (int)(y[i] * grid));
+    };
+    vector<int> start((size_t)grid * grid + 1, 0), order(n);
+    for(int i = 1; i <= n; i++) start[cellOf(i) + 1]++;
+    for(size_t c = 0; c + 1 < start.size(); c++) start[c + 1] += start[c];
+    vector<int> fill(start.begin(), start.end() - 1);
+    for(int i = 1; i <= n; i++) order[fill[cellOf(i)]++] = i;
+
+    edges.clear();
+    edges.reserve(m + m / 8);
+    const int forward[4][2] = {{0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    auto link = [&](int i, int j) {
+        double dx = x[i] - x[j], dy = y[i] - y[j], d = sqrt(dx * dx + dy * dy);
+        if(d < r) edges.push_back({i, j, (int)(d / r * 1e6)});
+    };
+    for(int cx = 0; cx < grid; cx++)
+        for(int cy = 0; cy < grid; cy++) {
+            int c = cx * grid + cy;
+            for(int a = start[c]; a < start[c + 1]; a++) {
+                for(int b = a + 1; b < start[c + 1]; b++) link(order[a], order[b]);
+                for(auto &f : forward) {
+                    int nx = cx + f[0], ny = cy + f[1];
+                    if(nx >= grid || ny < 0 || ny >= grid) continue;
+                    int d = nx * grid + ny;
+                    for(int b = start[d]; b < start[d + 1]; b++) link(order[a], order[b]);
+                }
+            }
+        }
+    shuffle(edges.begin(), edges.end(), rng);
+}
+
+// Sort-based Kruskal against Filter-Kruskal and Boruvka with 1, 2, 4, ... threads.
+int runBenchmark(int n, long long m) {
+    mt19937 rng(42);
+    vector<array<int,3>> edges;
+    auto t0 = chrono::steady_clock::now();
+    buildGeometricGraph(n, m, rng, edges);
+    printf("Random geometric graph: %d nodes, %zu edges (built in %.0f ms)\n\n", n, edges.size(), msSince(t0));
+
+    t0 = chrono::steady_clock::now();
+    vector<array<int,3>> expected = kruskalMst(n, edges);
+    double baseMs = msSince(t0);
+    printf("%-22s %12s %10s %10s\n", "engine", "time (ms)", "speedup", "MST edges");
+    printf("%-22s %12.0f %10.2f %10zu\n", "sort + Kruskal", baseMs, 1.0, expected.size());
+
+    int maxThreads = max(4u, thread::hardware_concurrency());
+    int mismatches = 0;
+    for(int mode = 0; mode < 2; mode++) {
+        for(int threads = 1; threads <= maxThreads; threads *= 2) {
+            t0 = chrono::steady_clock::now();
+            vector<array<int,3>> got = mode == 0 ? filterKruskalMst(n, edges, threads) : boruvkaMst(n, edges, threads);
+            double ms = msSince(t0);
+            if(got != expected) mismatches++;
+            char name[32];
+            snprintf(name, sizeof name, "%s x%d", mode == 0 ? "filter-Kruskal" : "Boruvka", threads);
+            printf("%-22s %12.0f %10.2f %10zu\n", name, ms, baseMs / ms, got.size());
+        }
+    }
+    printf("\nMST cost %lld (%u hardware threads) %d run(s) differ from sort + Kruskal\n",
+           totalCost(expected), thread::hardware_concurrency(), mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Complete graph against the k-NN-seeded MST on small inputs (uniform, two towns far apart,
+// and many small clustered sets, where the k-NN graph alone misses MST cables), then the
+// k-NN path alone on n random points, in one town and in two towns.
+int runGeometricBenchmark(int n, int k) {
+    mt19937 rng(42);
+    uniform_real_distribution<double> coord(0.0, 1e6);
+    auto randomPoints = [&](int count) {
+        vector<Point> pts(count + 1);
+        for(int i = 1; i <= count; i++) pts[i] = {coord(rng), coord(rng)};
+        return pts;
+    };
+    auto twoTowns = [&](int count) {
+        vector<Point> pts(count + 1);
+        for(int i = 1; i <= count; i++) pts[i] = {coord(rng) / 10 + (i > count / 2 ? 9e5 : 0), coord(rng) / 10};
+        return pts;
+    };
+    int threads = max(1u, thread::hardware_concurrency());
+
+    printf("%-8s %16s %16s %16s %16s\n", "nodes", "complete edges", "complete (ms)", "k-NN edges", "k-NN (ms)");
+    int mismatches = 0;
+    for(int small : {1000, 2000, 4000, -2000}) {  // Negative: split between two towns
+        bool split = small < 0;
+        small = abs(small);
+        vector<Point> pts = split ? twoTowns(small) : randomPoints(small);
+        auto t0 = chrono::steady_clock::now();
+        vector<array<int,3>> all = completeGraph(pts);
+        long long fullCost = totalCost(kruskalMst(small, all));
+        double fullMs = msSince(t0);
+
+        t0 = chrono::steady_clock::now();
+        long long knnCost = totalCost(geometricMst(pts, k, threads));
+        double knnMs = msSince(t0);
+        if(knnCost != fullCost) mismatches++;
+        printf("%-8d %16zu %16.1f %16lld %16.1f%s\n", small, all.size(), fullMs, (long long)small * k, knnMs,
+               split ? "  (two towns)" : "");
+    }
+
+    // Clustered layouts: 4-10 tight clusters of a few nodes each, spread over the map.
+    int clusteredSets = 150, clusteredMismatches = 0;
+    uniform_int_distribution<int> clusterCount(4, 10), clusterSize(2, 8);
+    uniform_real_distribution<double> spread(0.0, 2e4);
+    for(int set = 0; set < clusteredSets; set++) {
+        vector<Point> pts(1);
+        for(int c = clusterCount(rng); c > 0; c--) {
+            Point centre = {coord(rng), coord(rng)};
+            for(int s = clusterSize(rng); s > 0; s--) pts.push_back({centre.x + spread(rng), centre.y + spread(rng)});
+        }
+        int count = pts.size() - 1;
+        if(totalCost(geometricMst(pts, k, threads)) != totalCost(kruskalMst(count, completeGraph(pts))))
+            clusteredMismatches++;
+    }
+    mismatches += clusteredMismatches;
+    printf("%d clustered sets of 8-80 nodes: %d differ from the complete graph\n", clusteredSets, clusteredMismatches);
+
+    vector<Point> pts = randomPoints(n);
+    auto t0 = chrono::steady_clock::now();
+    KdTree tree(pts);
+    double buildMs = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    vector<array<int,3>> candidates = knnCandidateGraph(pts, tree, k, threads);
+    double knnMs = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    vector<array<int,3>> mst_edges = geometricMst(pts, k, threads);
+    double totalMs = msSince(t0);
+    printf("\n%d nodes, k = %d, %d thread(s): k-d tree %.0f ms, %zu candidate cables %.0f ms, MST end to end %.0f ms\n",
+           n, k, threads, buildMs, candidates.size(), knnMs, totalMs);
+    printf("MST cost %lld over %zu cables; %d small input(s) differ from the complete graph\n",
+           totalCost(mst_edges), mst_edges.size(), mismatches);
+
+    pts = twoTowns(n);
+    t0 = chrono::steady_clock::now();
+    mst_edges = geometricMst(pts, k, threads);
+    printf("Same %d nodes in two towns: MST end to end %.0f ms, %zu cables\n", n, msSince(t0), mst_edges.size());
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "kruskal";
+    if(mode == "bench")
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoll(argv[3]) : 50000000);
+    if(mode == "geo-bench")
+        return runGeometricBenchmark(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 10);
+    int threads = argc > 2 ? max(1, atoi(argv[2])) : max(1u, thread::hardware_concurrency());
+
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
 
+    if(mode == "points") {
+        int k = argc > 2 ? max(1, atoi(argv[2])) : 10;
+        int n;
+        cin >> n;
+        vector<Point> pts(n + 1);
+        for(int i = 1; i <= n; i++) cin >> pts[i].x >> pts[i].y;
+        vector<array<int,3>> mst_edges = geometricMst(pts, k, max(1u, thread::hardware_concurrency()));
+        cout << "Minimum Total Cost: " << totalCost(mst_edges) << "\n";
+        cout << "Edges in MST:\n";
+        for(auto &e : mst_edges) {
+            cout << e[0] << " " << e[1] << " " << e[2] << "\n";
+        }
+        return 0;
+    }
+
     int n, m;
     cin >> n >> m;
 
@@ -40,25 +728,12 @@ int main() {
         cin >> edges[i][0] >> edges[i][1] >> edges[i][2];
     }
 
-    // Sort edges by weight
-    sort(edges.begin(), edges.end(), [](auto &a, auto &b) {
-        return a[2] < b[2];
-    });
-
-    DSU dsu(n);
-    int mst_cost = 0;
     vector<array<int,3>> mst_edges;
+    if(mode == "filter") mst_edges = filterKruskalMst(n, edges, threads);
+    else if(mode == "boruvka") mst_edges = boruvkaMst(n, edges, threads);
+    else mst_edges = kruskalMst(n, edges);
 
-    for(auto &e : edges) {
-        int u = e[0], v = e[1], w = e[2];
-        if(dsu.find(u) != dsu.find(v)) {
-            dsu.unite(u, v);
-            mst_cost += w;
-            mst_edges.push_back({u, v, w});
-        }
-    }
-
-    cout << "Minimum Total Cost: " << mst_cost << "\n";
+    cout << "Minimum Total Cost: " << totalCost(mst_edges) << "\n";
     cout << "Edges in MST:\n";
     for(auto &e : mst_edges) {
         cout << e[0] << " " << e[1] << " " << e[2] << "\n";
@@ -2,42 +2,637 @@
 #include <vector>
 #include <queue>
 #include <limits>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <memory>
+#include <climits>
 using namespace std;
 
+// Usage: ./a.out                 interactive routing, followed by live road updates
+//        ./a.out dispatch        nearest station for every intersection (multi-source)
+//        ./a.out bench [side]    update latency vs full recomputation on a side x side grid
+//        ./a.out dispatch-bench [side stations]   multi-source throughput vs thread count
+//        ./a.out pq-bench [side queries]   Dijkstra with binary heap vs Dial buckets vs radix heap
+// Build with -pthread.
+
+const int INF = numeric_limits<int>::max();
+const int ROAD_CLOSED = numeric_limits<int>::max(); // Weight of a road that is shut
+
 // Structure to store edges
 struct Edge {
     int to;
     int weight;
 };
 
-// Dijkstra function
-vector<int> dijkstra(int start, int V, vector<vector<Edge>>& graph) {
-    vector<int> dist(V + 1, numeric_limits<int>::max());
+// One road change: travel time between u and v becomes 'weight' (ROAD_CLOSED to shut it)
+struct RoadUpdate {
+    int u, v;
+    int weight;
+};
+
+// --- Monotone priority queues for Dijkstra ---
+// Travel times are non-negative integers and Dijkstra never pushes a key below the last one
+// popped, so integer monotone queues can replace the comparison heap. All three share one
+// interface: push(key, v) inserts v or lowers its key, pop() returns the smallest (key, v).
+// Queues that cannot lower a key in place leave the old entry behind; the search skips it
+// because its key no longer matches dist[v].
+enum QueueKind { BINARY_HEAP, DIAL_BUCKETS, RADIX_HEAP };
+
+class BinaryHeapQueue {
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> heap;
+public:
+    void reset(int, int) { heap = {}; }
+    bool empty() const { return heap.empty(); }
+    void push(int key, int v) { heap.push({key, v}); }
+    pair<int, int> pop() {
+        pair<int, int> top = heap.top();
+        heap.pop();
+        return top;
+    }
+};
+
+// Dial's algorithm: with every road at most C long, all queued keys lie in
+// [current, current + C], so C + 1 circular buckets hold them without collisions.
+// Buckets are intrusive doubly-linked lists, so lowering a key moves the intersection
+// instead of duplicating it.
+class DialQueue {
+    int span = 1;
+    long long current = 0;
+    int count = 0;
+    vector<int> head, next, prev, key, bucket;
+    void unlink(int v) {
+        int b = bucket[v];
+        if (prev[v] != -1) next[prev[v]] = next[v]; else head[b] = next[v];
+        if (next[v] != -1) prev[next[v]] = prev[v];
+        bucket[v] = -1;
+        count--;
+    }
+public:
+    void reset(int V, int maxWeight) {
+        span = maxWeight + 1;
+        current = 0;
+        count = 0;
+        head.assign(span, -1);
+        next.resize(V + 1); prev.resize(V + 1); key.resize(V + 1);
+        bucket.assign(V + 1, -1);
+    }
+    bool empty() const { return count == 0; }
+    void push(int k, int v) {
+        if (bucket[v] != -1) unlink(v);
+        int b = k % span;
+        next[v] = head[b]; prev[v] = -1;
+        if (head[b] != -1) prev[head[b]] = v;
+        head[b] = v;
+        bucket[v] = b; key[v] = k;
+        count++;
+    }
+    pair<int, int> pop() {
+        while (head[current % span] == -1) current++;
+        int v = head[current % span];
+        unlink(v);
+        return {key[v], v};
+    }
+};
+
+// Radix heap: bucket i holds keys whose highest bit differing from the last popped key
+// is bit i-1. Each entry moves to a lower bucket at most 32 times over its lifetime.
+class RadixHeapQueue {
+    vector<pair<int, int>> buckets[33];
+    unsigned last = 0;
+    int count = 0;
+    static int bucketOf(unsigned k, unsigned last) { return k == last ? 0 : 32 - __builtin_clz(k ^ last); }
+public:
+    void reset(int, int) {
+        for (auto& b : buckets) b.clear();
+        last = 0;
+        count = 0;
+    }
+    bool empty() const { return count == 0; }
+    void push(int k, int v) {
+        buckets[bucketOf(k, last)].push_back({k, v});
+        count++;
+    }
+    pair<int, int> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            unsigned lowest = UINT_MAX;
+            for (auto& e : buckets[i]) lowest = min(lowest, (unsigned)e.first);
+            last = lowest;
+            for (auto& e : buckets[i]) buckets[bucketOf(e.first, last)].push_back(e);
+            buckets[i].clear();
+        }
+        pair<int, int> top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+};
+
+// Dial buckets are only worth it while the ring stays small; longer roads use the radix heap.
+const int MAX_DIAL_SPAN = 1 << 20;
+
+template <class Queue>
+vector<int> runDijkstra(int start, int V, vector<vector<Edge>>& graph, vector<int>* parent, int maxWeight) {
+    vector<int> dist(V + 1, INF);
     dist[start] = 0;
+    if (parent) parent->assign(V + 1, -1);
 
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-    pq.push({0, start}); // {distance, node}
+    Queue pq;
+    pq.reset(V, maxWeight);
+    pq.push(0, start); // {distance, node}
 
     while (!pq.empty()) {
-        auto [currentDist, node] = pq.top();
-        pq.pop();
+        auto [currentDist, node] = pq.pop();
 
         if (currentDist > dist[node]) continue;
 
         for (auto& edge : graph[node]) {
             int next = edge.to;
             int cost = edge.weight;
+            if (cost == ROAD_CLOSED) continue;
 
-            if (dist[node] + cost < dist[next]) {
-                dist[next] = dist[node] + cost;
-                pq.push({dist[next], next});
+            long long candidate = (long long)dist[node] + cost;
+            if (candidate < dist[next]) {
+                dist[next] = (int)candidate;
+                if (parent) (*parent)[next] = node;
+                pq.push(dist[next], next);
             }
         }
     }
     return dist;
 }
 
-int main() {
+// Dijkstra function; 'kind' picks the priority queue for this query.
+vector<int> dijkstra(int start, int V, vector<vector<Edge>>& graph, vector<int>* parent = nullptr,
+                     QueueKind kind = BINARY_HEAP) {
+    int maxWeight = 0;
+    if (kind == DIAL_BUCKETS) {
+        for (auto& list : graph)
+            for (auto& edge : list)
+                if (edge.weight != ROAD_CLOSED) maxWeight = max(maxWeight, edge.weight);
+        if (maxWeight >= MAX_DIAL_SPAN) kind = RADIX_HEAP;
+    }
+    switch (kind) {
+        case DIAL_BUCKETS: return runDijkstra<DialQueue>(start, V, graph, parent, maxWeight);
+        case RADIX_HEAP:   return runDijkstra<RadixHeapQueue>(start, V, graph, parent, maxWeight);
+        default:           return runDijkstra<BinaryHeapQueue>(start, V, graph, parent, maxWeight);
+    }
+}
+
+// Keeps the shortest-path tree from one start node up to date while roads change,
+// in the style of Ramalingam-Reps: only vertices whose distance or tree parent can
+// change are touched, instead of re-running Dijkstra over the whole city.
+class DynamicShortestPaths {
+    vector<vector<Edge>>& graph;
+    vector<int> dist, parent;
+    vector<int> affectedStamp; // affectedStamp[x] == round: x lost its tree path this round
+    int round = 0;
+    int touched = 0;
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+
+    // Sets every u->v entry in u's adjacency list to w; returns the quickest old weight
+    // (-1 if u and v were not connected, in which case a new road is added).
+    int setWeight(int u, int v, int w) {
+        int old = -1;
+        for (auto& e : graph[u])
+            if (e.to == v) {
+                if (old == -1 || e.weight < old) old = e.weight;
+                e.weight = w;
+            }
+        if (old == -1 && w != ROAD_CLOSED) graph[u].push_back({v, w});
+        return old;
+    }
+
+    bool affected(int x) const { return affectedStamp[x] == round; }
+
+    void relaxInto(int from, int to, int w) {
+        if (w == ROAD_CLOSED || dist[from] == INF) return;
+        long long candidate = (long long)dist[from] + w;
+        if (candidate < dist[to]) {
+            dist[to] = (int)candidate;
+            parent[to] = from;
+            pq.push({dist[to], to});
+        }
+    }
+
+public:
+    DynamicShortestPaths(int start, int V, vector<vector<Edge>>& graph)
+        : graph(graph), affectedStamp(V + 1, 0) {
+        dist = dijkstra(start, V, graph, &parent);
+    }
+
+    const vector<int>& distances() const { return dist; }
+    int lastTouched() const { return touched; } // Vertices visited by the last update
+
+    void applyUpdates(const vector<RoadUpdate>& updates) {
+        round++;
+        touched = 0;
+        vector<int> worse; // Tree children cut off by a slower or closed road
+
+        // 1. Change the graph and find tree edges that got slower.
+        for (const auto& up : updates) {
+            int old = setWeight(up.u, up.v, up.weight);
+            setWeight(up.v, up.u, up.weight);
+            if (old != -1 && up.weight > old) {
+                if (parent[up.v] == up.u) worse.push_back(up.v);
+                if (parent[up.u] == up.v) worse.push_back(up.u);
+            }
+        }
+
+        // 2. Everything below a slowed tree edge loses its distance. Children are found
+        //    through the graph itself (a tree child is always a neighbour), so this costs
+        //    only the degrees of the affected vertices.
+        vector<int> lost;
+        for (int x : worse)
+            if (!affected(x)) { affectedStamp[x] = round; lost.push_back(x); }
+        for (size_t i = 0; i < lost.size(); i++) {
+            int x = lost[i];
+            for (auto& e : graph[x])
+                if (parent[e.to] == x && !affected(e.to)) {
+                    affectedStamp[e.to] = round;
+                    lost.push_back(e.to);
+                }
+        }
+        for (int x : lost) { dist[x] = INF; parent[x] = -1; }
+        touched += lost.size();
+
+        // 3. Re-attach each cut-off vertex to its best neighbour outside the cut.
+        for (int x : lost)
+            for (auto& e : graph[x])
+                if (!affected(e.to)) relaxInto(e.to, x, e.weight);
+
+        // 4. Roads that got faster may offer shortcuts in either direction. A road can be
+        //    changed more than once per batch, so relax with its final weight in the graph.
+        for (const auto& up : updates) {
+            for (auto& e : graph[up.u])
+                if (e.to == up.v) relaxInto(up.u, up.v, e.weight);
+            for (auto& e : graph[up.v])
+                if (e.to == up.u) relaxInto(up.v, up.u, e.weight);
+        }
+
+        // 5. Propagate from the seeded vertices only.
+        while (!pq.empty()) {
+            auto [d, x] = pq.top();
+            pq.pop();
+            if (d > dist[x]) continue;
+            touched++;
+            for (auto& e : graph[x]) relaxInto(x, e.to, e.weight);
+        }
+    }
+};
+
+// --- Multi-source dispatch planning ---
+// For every intersection: the nearest station and the travel time from it. Ties go to the
+// station listed first, so the answer does not depend on thread scheduling. Distance and
+// station index are packed into one 64-bit word (distance in the high half) so a single
+// atomic min keeps both consistent.
+typedef unsigned long long Label;
+const Label NO_LABEL = ~0ULL;
+
+inline Label packLabel(int dist, int station) { return ((Label)(unsigned)dist << 32) | (unsigned)station; }
+inline int labelDist(Label l) { return l == NO_LABEL ? INF : (int)(l >> 32); }
+inline int labelStation(Label l) { return l == NO_LABEL ? -1 : (int)(l & 0xffffffffu); }
+
+// Sequential reference: Dijkstra seeded with every station at distance 0.
+vector<Label> nearestStationsSequential(const vector<int>& stations, int V, vector<vector<Edge>>& graph) {
+    vector<Label> best(V + 1, NO_LABEL);
+    priority_queue<pair<Label, int>, vector<pair<Label, int>>, greater<pair<Label, int>>> pq;
+    for (int i = 0; i < (int)stations.size(); i++)
+        if (packLabel(0, i) < best[stations[i]]) {
+            best[stations[i]] = packLabel(0, i);
+            pq.push({best[stations[i]], stations[i]});
+        }
+    while (!pq.empty()) {
+        auto [l, node] = pq.top();
+        pq.pop();
+        if (l > best[node]) continue;
+        for (auto& edge : graph[node]) {
+            if (edge.weight == ROAD_CLOSED) continue;
+            long long d = (long long)labelDist(l) + edge.weight;
+            if (d >= INF) continue;
+            Label next = packLabel((int)d, labelStation(l));
+            if (next < best[edge.to]) {
+                best[edge.to] = next;
+                pq.push({next, edge.to});
+            }
+        }
+    }
+    return best;
+}
+
+// Reusable all-threads rendezvous point.
+class SpinBarrier {
+    const int count;
+    atomic<int> waiting{0};
+    atomic<int> generation{0};
+public:
+    explicit SpinBarrier(int count) : count(count) {}
+    void wait() {
+        int gen = generation.load();
+        if (waiting.fetch_add(1) + 1 == count) {
+            waiting.store(0);
+            generation.fetch_add(1);
+        } else {
+            while (generation.load() == gen) this_thread::yield();
+        }
+    }
+};
+
+// Parallel delta-stepping. Intersections are grouped into buckets of width 'delta' by
+// tentative distance; all threads drain the current bucket together, taking chunks of
+// the shared frontier from an atomic cursor, and push improved intersections into
+// thread-local buckets. The lowest non-empty bucket across threads becomes the next
+// frontier. Buffers are kept, so replanning as vehicles move allocates nothing new.
+// Live tentative distances never span more than maxWeight/delta + 2 buckets, so the local
+// buckets form a ring of that size; delta is raised if the ring would get too large.
+class DispatchPlanner {
+    int V;
+    vector<vector<Edge>>& graph;
+    unique_ptr<atomic<Label>[]> best;
+    vector<int> frontier;
+
+public:
+    DispatchPlanner(int V, vector<vector<Edge>>& graph) : V(V), graph(graph), best(new atomic<Label>[V + 1]) {
+        size_t arcs = 0;
+        for (auto& list : graph) arcs += list.size();
+        frontier.resize(arcs + V + 1);
+    }
+
+    static const size_t MAX_RING = 1 << 12;
+
+    vector<Label> plan(const vector<int>& stations, int threads, int delta) {
+        for (int v = 0; v <= V; v++) best[v].store(NO_LABEL, memory_order_relaxed);
+
+        long long maxWeight = 0;
+        for (auto& list : graph)
+            for (auto& edge : list)
+                if (edge.weight != ROAD_CLOSED) maxWeight = max(maxWeight, (long long)edge.weight);
+        delta = (int)max({1LL, (long long)delta, (maxWeight + (long long)MAX_RING - 3) / ((long long)MAX_RING - 2)});
+        const size_t ring = maxWeight / delta + 2;
+
+        const size_t CHUNK = 64;
+        atomic<size_t> frontierTail{0}, cursor{0};
+        atomic<size_t> nextBucket{SIZE_MAX};
+        for (int i = 0; i < (int)stations.size(); i++) {
+            Label l = packLabel(0, i);
+            if (l < best[stations[i]].load()) {
+                best[stations[i]].store(l);
+                frontier[frontierTail++] = stations[i];
+            }
+        }
+
+        SpinBarrier barrier(threads);
+        auto worker = [&](int id) {
+            vector<vector<int>> local(ring); // Bucket b lives in local[b % ring]
+            size_t bucket = 0;
+            while (true) {
+                size_t size = frontierTail.load();
+                if (size == 0) break;
+
+                // 1. Drain the current bucket.
+                for (size_t start = cursor.fetch_add(CHUNK); start < size; start = cursor.fetch_add(CHUNK)) {
+                    for (size_t i = start; i < min(size, start + CHUNK); i++) {
+                        int u = frontier[i];
+                        Label lu = best[u].load(memory_order_relaxed);
+                        if ((size_t)labelDist(lu) / delta < bucket) continue; // Settled in an earlier bucket
+                        for (auto& edge : graph[u]) {
+                            if (edge.weight == ROAD_CLOSED) continue;
+                            long long d = (long long)labelDist(lu) + edge.weight;
+                            if (d >= INF) continue; // Beyond the representable travel time
+                            Label next = packLabel((int)d, labelStation(lu));
+                            Label seen = best[edge.to].load(memory_order_relaxed);
+                            while (next < seen && !best[edge.to].compare_exchange_weak(seen, next)) {}
+                            if (next < seen) local[(size_t)d / delta % ring].push_back(edge.to);
+                        }
+                    }
+                }
+                barrier.wait();
+
+                // 2. Agree on the lowest non-empty bucket across all threads.
+                size_t mine = SIZE_MAX;
+                for (size_t b = bucket; b < bucket + ring; b++)
+                    if (!local[b % ring].empty()) { mine = b; break; }
+                size_t seen = nextBucket.load();
+                while (mine < seen && !nextBucket.compare_exchange_weak(seen, mine)) {}
+                barrier.wait();
+                size_t chosen = nextBucket.load();
+                if (chosen == SIZE_MAX) break;
+                bucket = chosen;
+                barrier.wait();
+
+                // 3. Rebuild the shared frontier from everyone's share of that bucket.
+                if (id == 0) {
+                    frontierTail.store(0);
+                    cursor.store(0);
+                    nextBucket.store(SIZE_MAX);
+                }
+                barrier.wait();
+                vector<int>& mineChosen = local[chosen % ring];
+                size_t share = mineChosen.size();
+                size_t at = frontierTail.fetch_add(share);
+                barrier.wait();
+                if (id == 0 && frontierTail.load() > frontier.size()) frontier.resize(frontierTail.load() * 2);
+                barrier.wait();
+                if (share) {
+                    copy(mineChosen.begin(), mineChosen.end(), frontier.begin() + at);
+                    mineChosen.clear();
+                }
+                barrier.wait();
+            }
+        };
+
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+
+        vector<Label> result(V + 1);
+        for (int v = 0; v <= V; v++) result[v] = best[v].load();
+        return result;
+    }
+};
+
+void printTravelTimes(const vector<int>& result, int V) {
+    cout << "\n--- Fastest Travel Time to All Locations ---\n";
+    for (int i = 1; i <= V; i++) {
+        cout << "Node " << i << " : ";
+        if (result[i] == INF)
+            cout << "UNREACHABLE\n";
+        else
+            cout << result[i] << " units\n";
+    }
+}
+
+double msSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+// Grid city of side x side intersections (1-based) with 1-20 unit two-way roads.
+void buildGridCity(int side, mt19937& rng, vector<vector<Edge>>& graph, vector<pair<int, int>>& roads) {
+    uniform_int_distribution<int> minutes(1, 20);
+    graph.assign(side * side + 1, {});
+    roads.clear();
+    for (int r = 0; r < side; r++)
+        for (int c = 0; c < side; c++) {
+            int id = r * side + c + 1;
+            if (c + 1 < side) roads.push_back({id, id + 1});
+            if (r + 1 < side) roads.push_back({id, id + side});
+        }
+    for (auto [u, v] : roads) {
+        int w = minutes(rng);
+        graph[u].push_back({v, w});
+        graph[v].push_back({u, w});
+    }
+}
+
+// Grid city of side x side intersections; batches of random closures, slow-downs and
+// reopenings are applied incrementally and checked against a full recomputation.
+int runBenchmark(int side) {
+    int V = side * side;
+    mt19937 rng(42);
+    uniform_int_distribution<int> minutes(1, 20);
+    vector<vector<Edge>> graph;
+    vector<pair<int, int>> roads;
+    buildGridCity(side, rng, graph, roads);
+
+    printf("Grid city: %d intersections, %zu roads\n", V, roads.size());
+    auto t0 = chrono::steady_clock::now();
+    DynamicShortestPaths live(1, V, graph);
+    printf("Initial Dijkstra: %.1f ms\n\n", msSince(t0));
+
+    printf("%-10s %16s %16s %14s\n", "changes", "incremental", "recompute", "touched");
+    uniform_int_distribution<int> pickRoad(0, roads.size() - 1), kind(0, 3);
+    int mismatches = 0;
+    for (int batch : {1, 10, 100, 1000, -100}) { // Negative: every road changed twice
+        bool twice = batch < 0;
+        batch = abs(batch);
+        vector<RoadUpdate> updates;
+        for (int i = 0; i < batch; i++) {
+            auto [u, v] = roads[pickRoad(rng)];
+            int k = kind(rng);
+            int w = k == 0 ? ROAD_CLOSED : k == 1 ? minutes(rng) * 3 : minutes(rng);
+            if (twice) updates.push_back({u, v, 1}); // Briefly the fastest road in town
+            updates.push_back({u, v, w});
+        }
+
+        t0 = chrono::steady_clock::now();
+        live.applyUpdates(updates);
+        double incMs = msSince(t0);
+
+        t0 = chrono::steady_clock::now();
+        vector<int> full = dijkstra(1, V, graph);
+        double fullMs = msSince(t0);
+
+        if (full != live.distances()) mismatches++;
+        printf("%-10s %13.3f ms %13.3f ms %14d\n", (to_string(batch) + (twice ? " x2" : "")).c_str(),
+               incMs, fullMs, live.lastTouched());
+    }
+
+    // A road sped up and then slowed down again in the same batch: 1-2(5), 2-3(5).
+    vector<vector<Edge>> path(4);
+    for (auto [u, v] : {pair<int, int>{1, 2}, {2, 3}}) {
+        path[u].push_back({v, 5});
+        path[v].push_back({u, 5});
+    }
+    DynamicShortestPaths small(1, 3, path);
+    small.applyUpdates({{1, 2, 3}, {1, 2, 10}});
+    if (small.distances() != dijkstra(1, 3, path)) mismatches++;
+    printf("\n%d batch(es) differ from full recomputation\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Full-city Dijkstra from random start points with each priority queue, on grid cities with
+// short, medium and long road ranges; all queues must agree on every distance.
+int runQueueBenchmark(int side, int queries) {
+    mt19937 rng(42);
+    vector<vector<Edge>> graph;
+    vector<pair<int, int>> roads;
+    buildGridCity(side, rng, graph, roads);
+    int V = side * side;
+    const char* names[] = {"binary heap", "Dial buckets", "radix heap"};
+
+    printf("Grid city: %d intersections, %zu roads, %d queries per row\n\n", V, roads.size(), queries);
+    printf("%-12s %16s %16s %16s\n", "max weight", names[0], names[1], names[2]);
+    uniform_int_distribution<int> pick(1, V);
+    int mismatches = 0;
+    for (int maxWeight : {20, 1000, 100000}) {
+        uniform_int_distribution<int> weight(1, maxWeight);
+        graph.assign(V + 1, {});
+        for (auto [u, v] : roads) {
+            int w = weight(rng);
+            graph[u].push_back({v, w});
+            graph[v].push_back({u, w});
+        }
+        vector<int> starts(queries);
+        for (int& s : starts) s = pick(rng);
+
+        double ms[3];
+        vector<vector<int>> answers[3];
+        for (int k = 0; k < 3; k++) {
+            auto t0 = chrono::steady_clock::now();
+            for (int s : starts) answers[k].push_back(dijkstra(s, V, graph, nullptr, (QueueKind)k));
+            ms[k] = msSince(t0) / queries;
+        }
+        if (answers[1] != answers[0] || answers[2] != answers[0]) mismatches++;
+        printf("%-12d %13.2f ms %13.2f ms %13.2f ms\n", maxWeight, ms[0], ms[1], ms[2]);
+    }
+    printf("\n%d weight range(s) where the queues disagree\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Nearest-station labelling for the whole city with 1, 2, 4, ... threads.
+int runDispatchBenchmark(int side, int numStations) {
+    mt19937 rng(42);
+    vector<vector<Edge>> graph;
+    vector<pair<int, int>> roads;
+    buildGridCity(side, rng, graph, roads);
+    int V = side * side;
+
+    uniform_int_distribution<int> pick(1, V);
+    vector<int> stations(numStations);
+    for (int& s : stations) s = pick(rng);
+
+    auto t0 = chrono::steady_clock::now();
+    vector<Label> expected = nearestStationsSequential(stations, V, graph);
+    double seqMs = msSince(t0);
+
+    printf("Grid city: %d intersections, %d stations\n\n", V, numStations);
+    printf("%-22s %12s %18s\n", "engine", "time (ms)", "intersections/s");
+    printf("%-22s %12.1f %18.3g\n", "sequential Dijkstra", seqMs, V / seqMs * 1000);
+
+    DispatchPlanner planner(V, graph);
+    int maxThreads = max(4u, thread::hardware_concurrency());
+    int mismatches = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        t0 = chrono::steady_clock::now();
+        vector<Label> got = planner.plan(stations, threads, 20);
+        double ms = msSince(t0);
+        if (got != expected) mismatches++;
+        char name[32];
+        snprintf(name, sizeof name, "delta-stepping x%d", threads);
+        printf("%-22s %12.1f %18.3g\n", name, ms, V / ms * 1000);
+    }
+    printf("\n(%u hardware threads) %d run(s) differ from the sequential labels\n",
+           thread::hardware_concurrency(), mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench")
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 1000);
+    if (argc > 1 && string(argv[1]) == "pq-bench")
+        return runQueueBenchmark(argc > 2 ? atoi(argv[2]) : 1000, argc > 3 ? atoi(argv[3]) : 5);
+    if (argc > 1 && string(argv[1]) == "dispatch-bench")
+        return runDispatchBenchmark(argc > 2 ? atoi(argv[2]) : 1000, argc > 3 ? atoi(argv[3]) : 64);
+    bool dispatchMode = argc > 1 && string(argv[1]) == "dispatch";
+
     int V, E;
     cout << "\n=== Emergency Vehicle Rapid Response Routing ===\n";
     cout << "Enter number of intersections (nodes): ";
@@ -59,21 +654,57 @@ int main() {
         graph[v].push_back({u, w}); // Bidirectional roads
     }
 
+    if (dispatchMode) {
+        int count;
+        cout << "\nEnter number of available ambulances/fire stations: ";
+        cin >> count;
+        vector<int> stations;
+        cout << "Enter their intersections: ";
+        for (int i = 0; i < count; i++) {
+            int s;
+            cin >> s;
+            if (s >= 1 && s <= V) stations.push_back(s);
+        }
+
+        DispatchPlanner planner(V, graph);
+        int threads = max(1u, thread::hardware_concurrency());
+        vector<Label> result = planner.plan(stations, threads, 10);
+
+        cout << "\n--- Nearest Station for Every Location ---\n";
+        for (int i = 1; i <= V; i++) {
+            cout << "Node " << i << " : ";
+            if (result[i] == NO_LABEL)
+                cout << "UNREACHABLE\n";
+            else
+                cout << "station at node " << stations[labelStation(result[i])] << ", "
+                     << labelDist(result[i]) << " units\n";
+        }
+        return 0;
+    }
+
     int start;
     cout << "\nEnter ambulance/fire-truck starting node: ";
     cin >> start;
 
-    vector<int> result = dijkstra(start, V, graph);
+    DynamicShortestPaths live(start, V, graph);
+    printTravelTimes(live.distances(), V);
 
-    cout << "\n--- Fastest Travel Time to All Locations ---\n";
-    for (int i = 1; i <= V; i++) {
-        cout << "Node " << i << " : ";
-        if (result[i] == numeric_limits<int>::max())
-            cout << "UNREACHABLE\n";
-        else
-            cout << result[i] << " units\n";
+    // Live traffic: apply batches of road changes without recomputing from scratch.
+    int changes;
+    while (true) {
+        cout << "\nEnter number of road changes (0 to exit): ";
+        if (!(cin >> changes) || changes <= 0) break;
+        cout << "From  To  NewTravelTime (-1 = road closed)\n";
+        vector<RoadUpdate> updates;
+        for (int i = 0; i < changes; i++) {
+            int u, v, w;
+            cin >> u >> v >> w;
+            if (u < 1 || u > V || v < 1 || v > V) continue;
+            updates.push_back({u, v, w < 0 ? ROAD_CLOSED : w});
+        }
+        live.applyUpdates(updates);
+        printTravelTimes(live.distances(), V);
     }
 
     return 0;
 }
-
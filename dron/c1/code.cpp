@@ -1,111 +1,2260 @@
 // This program implements Dijkstra's algorithm to find the shortest route between two locations.
-// The current graph is based on sample data generated for our city map project.
-// It is fully functional for these nodes and edges, but the graph can be easily expanded
-// by adding more junctions, roads, and corresponding distances or travel times.
+// The road network is loaded from nodes.csv / edges.csv (the sample data generated for our
+// city map project) into a compressed-sparse-row (CSR) graph, so the same code can load a
+// city-scale network with millions of junctions by simply pointing it at bigger CSV files.
+//
+// Usage:
+//   ./code                              interactive query on ./nodes.csv and ./edges.csv
+//   ./code <nodes.csv> <edges.csv>      interactive query on another map
+//   ./code bench [rows cols queries]    load-time / per-query benchmark, CSR vs adjacency lists
+//   ./code pq-bench [queries]           Dijkstra with binary heap vs Dial buckets vs radix heap
+//   ./code ch-build <nodes> <edges> <out.ch>   offline contraction-hierarchy preprocessing
+//   ./code ch <city.ch> [nodes edges]   interactive query answered from a prebuilt hierarchy
+//   ./code ch-bench [rows cols queries] CH preprocessing + query benchmark, checked against Dijkstra
+//   ./code alt-build <nodes> <edges> <out.alt> [landmarks]   precompute ALT landmark tables
+//   ./code alt <city.alt> [nodes edges] interactive query answered by A* with landmarks
+//   ./code alt-bench [rows cols queries landmarks]   settled junctions / latency vs Dijkstra
+//   ./code td <profiles.csv> [nodes edges]   "leave at HH:MM" query with time-dependent travel times
+//   ./code td-profiles <nodes> <edges> <out.csv>   write synthetic rush-hour profiles for a map
+//   ./code td-bench [rows cols queries] profile compression + time-dependent query benchmark
+//   ./code routes <k> [nodes edges]    interactive query listing up to k alternative routes
+//   ./code routes-bench [rows cols queries]   alternative-route latency for k = 1 .. 5
+//   ./code serve [--socket path] [--ch file | --alt file] [--threads N] [nodes edges]
+//                                       routing daemon answering JSON lines (stdin or a Unix socket)
+//   ./code serve-bench [rows cols requests clients threads engine]   daemon p50/p99 latency
 #include <iostream>
 #include <vector>
 #include <queue>
 #include <climits>
 #include <unordered_map>
 #include <string>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 using namespace std;
 
 typedef pair<int, int> pii;
 
-class CityGraph {
-    int V;
-    vector<vector<pii>> adj;
+// --- Streaming CSV reader ---
+// Reads the file through one fixed-size buffer and hands out one line at a time,
+// so loading never holds more than a single chunk of the raw text in memory.
+class CsvLineReader {
+    FILE* fp;
+    vector<char> buf;
+    size_t pos = 0, len = 0;
+    string carry; // line that straddles two chunks
 public:
-    CityGraph(int V) {
-        this->V = V;
-        adj.resize(V);
+    explicit CsvLineReader(const string& path) : fp(fopen(path.c_str(), "rb")), buf(1 << 20) {}
+    ~CsvLineReader() { if (fp) fclose(fp); }
+    bool ok() const { return fp != nullptr; }
+
+    // Returns false at end of file. 'line' points into the reader's buffer and stays
+    // valid until the next call.
+    bool next(const char*& line, size_t& n) {
+        carry.clear();
+        while (true) {
+            if (pos == len) {
+                len = fread(buf.data(), 1, buf.size(), fp);
+                pos = 0;
+                if (len == 0) {
+                    if (carry.empty()) return false;
+                    line = carry.data(); n = carry.size();
+                    return true;
+                }
+            }
+            const char* start = buf.data() + pos;
+            const char* nl = (const char*)memchr(start, '\n', len - pos);
+            if (!nl) {
+                carry.append(start, len - pos);
+                pos = len;
+                continue;
+            }
+            size_t k = nl - start;
+            pos += k + 1;
+            if (carry.empty()) { line = start; n = k; }
+            else { carry.append(start, k); line = carry.data(); n = carry.size(); }
+            if (n > 0 && line[n - 1] == '\r') n--;
+            return true;
+        }
     }
+};
 
-    void addRoad(int u, int v, int w) {
-        adj[u].push_back({v, w});
-        adj[v].push_back({u, w}); // Bidirectional
+// Splits a CSV line into at most 'maxFields' comma-separated fields (the last field keeps
+// any remaining commas). Returns the number of fields found.
+int splitFields(const char* line, size_t n, const char** f, size_t* flen, int maxFields) {
+    int k = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= n && k < maxFields; i++) {
+        if (i == n || (line[i] == ',' && k < maxFields - 1)) {
+            f[k] = line + start;
+            flen[k] = i - start;
+            k++;
+            start = i + 1;
+        }
     }
+    return k;
+}
 
-    void shortestPath(int src, int dest, unordered_map<int, string>& idToName) {
-        vector<int> dist(V, INT_MAX);
-        vector<int> parent(V, -1);
-        priority_queue<pii, vector<pii>, greater<pii>> pq;
+// Travel times are whole minutes; fractional values in the CSV are rounded.
+int parseMinutes(const char* s, size_t n) {
+    double v = 0;
+    if (from_chars(s, s + n, v).ec != errc()) return -1;
+    return (int)(v + 0.5);
+}
+
+// --- Monotone priority queues for Dijkstra ---
+// Travel times are small non-negative integers and Dijkstra never pushes a key below the
+// last one popped, so integer monotone queues can replace the comparison heap. All three
+// share the same interface: push(key, v) inserts v or lowers its key, pop() returns the
+// smallest (key, v). Queues that cannot lower a key in place leave the old entry behind;
+// the search skips it because its key no longer matches dist[v].
+enum QueueKind { BINARY_HEAP, DIAL_BUCKETS, RADIX_HEAP };
+
+class BinaryHeapQueue {
+    vector<pii> heap;
+public:
+    void reset(int, int) { heap.clear(); }
+    bool empty() const { return heap.empty(); }
+    void push(int key, int v) {
+        heap.push_back({key, v});
+        push_heap(heap.begin(), heap.end(), greater<pii>());
+    }
+    pii pop() {
+        pop_heap(heap.begin(), heap.end(), greater<pii>());
+        pii top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+};
+
+// Dial's algorithm: with every road at most C minutes long, all queued keys lie in
+// [current, current + C], so C + 1 circular buckets hold them without collisions.
+// Buckets are intrusive doubly-linked lists, so lowering a key moves the junction
+// instead of duplicating it.
+class DialQueue {
+    int span = 1;
+    long long current = 0;
+    int count = 0;
+    vector<int> head, next, prev, key, bucket;
+    void unlink(int v) {
+        int b = bucket[v];
+        if (prev[v] != -1) next[prev[v]] = next[v]; else head[b] = next[v];
+        if (next[v] != -1) prev[next[v]] = prev[v];
+        bucket[v] = -1;
+        count--;
+    }
+public:
+    void reset(int V, int maxWeight) {
+        span = maxWeight + 1;
+        current = 0;
+        count = 0;
+        head.assign(span, -1);
+        next.resize(V); prev.resize(V); key.resize(V);
+        bucket.assign(V, -1);
+    }
+    bool empty() const { return count == 0; }
+    void push(int k, int v) {
+        if (bucket[v] != -1) unlink(v);
+        int b = k % span;
+        next[v] = head[b]; prev[v] = -1;
+        if (head[b] != -1) prev[head[b]] = v;
+        head[b] = v;
+        bucket[v] = b; key[v] = k;
+        count++;
+    }
+    pii pop() {
+        while (head[current % span] == -1) current++;
+        int v = head[current % span];
+        unlink(v);
+        return {key[v], v};
+    }
+};
+
+// Radix heap: bucket i holds keys whose highest bit differing from the last popped key
+// is bit i-1. Each entry moves to a lower bucket at most 32 times over its lifetime.
+class RadixHeapQueue {
+    vector<pii> buckets[33];
+    unsigned last = 0;
+    int count = 0;
+    static int bucketOf(unsigned k, unsigned last) { return k == last ? 0 : 32 - __builtin_clz(k ^ last); }
+public:
+    void reset(int, int) {
+        for (auto& b : buckets) b.clear();
+        last = 0;
+        count = 0;
+    }
+    bool empty() const { return count == 0; }
+    void push(int k, int v) {
+        buckets[bucketOf(k, last)].push_back({k, v});
+        count++;
+    }
+    pii pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            unsigned lowest = UINT_MAX;
+            for (auto& e : buckets[i]) lowest = min(lowest, (unsigned)e.first);
+            last = lowest;
+            for (auto& e : buckets[i]) buckets[bucketOf(e.first, last)].push_back(e);
+            buckets[i].clear();
+        }
+        pii top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+};
+
+// Per-thread scratch space for one-directional searches (Dijkstra, A*). Arrays are never
+// cleared between queries: an entry is valid only if its stamp equals the current
+// version, so a query costs O(junctions touched) instead of O(V).
+struct SearchWorkspace {
+    vector<int> dist, parent, stamp;
+    vector<int> bound, boundStamp; // Cached heuristic per junction
+    vector<pii> heap;
+    vector<int> targetDist; // d(L_i, target) for the current query
+    int version = 0;
+    int settled = 0;
+
+    void prepare(int V) {
+        if ((int)stamp.size() != V) {
+            dist.assign(V, INT_MAX); parent.assign(V, -1); stamp.assign(V, 0);
+            bound.assign(V, 0); boundStamp.assign(V, 0);
+        }
+        if (++version == INT_MAX) {
+            fill(stamp.begin(), stamp.end(), 0);
+            fill(boundStamp.begin(), boundStamp.end(), 0);
+            version = 1;
+        }
+        heap.clear();
+        settled = 0;
+    }
+    int get(int v) const { return stamp[v] == version ? dist[v] : INT_MAX; }
+    void set(int v, int d, int from) { stamp[v] = version; dist[v] = d; parent[v] = from; }
+
+    // Junction sequence from the search source to v (empty if v was not reached).
+    void pathTo(int v, vector<int>& path) const {
+        path.clear();
+        if (get(v) == INT_MAX) return;
+        for (; v != -1; v = parent[v]) path.push_back(v);
+        reverse(path.begin(), path.end());
+    }
+};
+
+class CityGraph {
+    int V = 0;
+    // CSR layout: the roads leaving junction u are target[offset[u] .. offset[u+1]-1]
+    // with matching travel times in weight[]. Every road is stored in both directions.
+    vector<int> offset;
+    vector<int> target;
+    vector<int> weight;
+    int maxTime = 0; // Longest single road, bounds the Dial bucket ring
+    vector<string> names;
+    unordered_map<string, int> placeIndex; // place name -> junction id
+    vector<string> junctionIds;                 // node_id from nodes.csv (loaded maps only)
+    unordered_map<string, int> junctionIndex;   // node_id -> junction id
+
+    template <class Queue>
+    int runDijkstra(int src, int dest, vector<int>& dist, vector<int>& parent) const {
+        dist.assign(V, INT_MAX);
+        parent.assign(V, -1);
+        Queue pq;
+        pq.reset(V, maxTime);
 
         dist[src] = 0;
-        pq.push({0, src});
+        pq.push(0, src);
 
         while (!pq.empty()) {
-            int u = pq.top().second;
-            int d = pq.top().first;
-            pq.pop();
+            auto [d, u] = pq.pop();
 
             if (d > dist[u]) continue;
+            if (u == dest) break;
 
-            for (auto edge : adj[u]) {
-                int v = edge.first;
-                int w = edge.second;
-                if (dist[u] + w < dist[v]) {
-                    dist[v] = dist[u] + w;
+            for (int e = offset[u]; e < offset[u + 1]; e++) {
+                int v = target[e];
+                int w = weight[e];
+                if (d + w < dist[v]) {
+                    dist[v] = d + w;
                     parent[v] = u;
-                    pq.push({dist[v], v});
+                    pq.push(dist[v], v);
                 }
             }
         }
+        return dest < 0 ? 0 : dist[dest];
+    }
+public:
+    // Loads the map in a single streaming pass over each file. Edges are buffered as flat
+    // (u, v, w) triples, then scattered into place with a counting sort, so no
+    // per-junction vectors are ever allocated.
+    bool loadFromCSV(const string& nodesPath, const string& edgesPath) {
+        CsvLineReader nodes(nodesPath), edges(edgesPath);
+        if (!nodes.ok() || !edges.ok()) {
+            cerr << "Could not open " << (nodes.ok() ? edgesPath : nodesPath) << "\n";
+            return false;
+        }
+
+        const char* line; size_t n;
+        const char* f[4]; size_t fl[4];
+        unordered_map<string, int> nodeId; // CSV node_id (e.g. "N1") -> dense id
+
+        nodes.next(line, n); // Skip header
+        while (nodes.next(line, n)) {
+            if (splitFields(line, n, f, fl, 2) < 2) continue;
+            int id = names.size();
+            if (!nodeId.emplace(string(f[0], fl[0]), id).second) continue; // Duplicate id
+            names.emplace_back(f[1], fl[1]);
+            junctionIds.emplace_back(f[0], fl[0]);
+        }
+        V = names.size();
 
-        if (dist[dest] == INT_MAX) {
-            cout << "No path found from " << idToName[src] << " to " << idToName[dest] << endl;
+        vector<int> eu, ev, ew;
+        long long skipped = 0;
+        string key;
+        edges.next(line, n); // Skip header
+        while (edges.next(line, n)) {
+            if (splitFields(line, n, f, fl, 4) < 4) continue;
+            key.assign(f[0], fl[0]);
+            auto a = nodeId.find(key);
+            key.assign(f[1], fl[1]);
+            auto b = nodeId.find(key);
+            int w = parseMinutes(f[3], fl[3]);
+            if (a == nodeId.end() || b == nodeId.end() || w < 0) { skipped++; continue; }
+            eu.push_back(a->second); ev.push_back(b->second); ew.push_back(w);
+        }
+        if (skipped)
+            cerr << "Warning: skipped " << skipped << " road(s) with unknown junctions or bad times.\n";
+
+        assignRoads(V, eu, ev, ew);
+        junctionIndex = move(nodeId);
+        return true;
+    }
+
+    // Builds the CSR arrays from flat (eu[i], ev[i], ew[i]) two-way roads. Junctions without
+    // a name from nodes.csv are called "Junction <id>".
+    void assignRoads(int junctions, const vector<int>& eu, const vector<int>& ev, const vector<int>& ew) {
+        V = junctions;
+        for (int u = names.size(); u < V; u++) names.push_back("Junction " + to_string(u));
+
+        offset.assign(V + 1, 0);
+        for (size_t i = 0; i < eu.size(); i++) { offset[eu[i] + 1]++; offset[ev[i] + 1]++; }
+        for (int u = 0; u < V; u++) offset[u + 1] += offset[u];
+        target.resize(offset[V]);
+        weight.resize(offset[V]);
+        maxTime = 0;
+        vector<int> fill(offset.begin(), offset.end() - 1);
+        for (size_t i = 0; i < eu.size(); i++) {
+            int u = eu[i], v = ev[i], w = ew[i];
+            target[fill[u]] = v; weight[fill[u]++] = w;
+            target[fill[v]] = u; weight[fill[v]++] = w; // Bidirectional
+            maxTime = max(maxTime, w);
+        }
+
+        placeIndex.clear();
+        placeIndex.reserve(V);
+        for (int u = 0; u < V; u++) placeIndex.emplace(names[u], u);
+    }
+
+    int size() const { return V; }
+    long long roadCount() const { return target.size() / 2; }
+    const string& placeName(int u) const { return names[u]; }
+
+    // Raw CSR access for the preprocessing engines below.
+    int roadBegin(int u) const { return offset[u]; }
+    int roadEnd(int u) const { return offset[u + 1]; }
+    int roadTo(int e) const { return target[e]; }
+    int roadTime(int e) const { return weight[e]; }
+
+    // Travel time of the quickest direct road u -> v, or -1 if they are not adjacent.
+    int directTime(int u, int v) const {
+        int best = -1;
+        for (int e = offset[u]; e < offset[u + 1]; e++)
+            if (target[e] == v && (best == -1 || weight[e] < best)) best = weight[e];
+        return best;
+    }
+
+    int findPlace(const string& name) const {
+        auto it = placeIndex.find(name);
+        return it == placeIndex.end() ? -1 : it->second;
+    }
+
+    // Junction for a node_id as written in the CSV files, or -1.
+    int findJunction(const string& id) const {
+        auto it = junctionIndex.find(id);
+        return it == junctionIndex.end() ? -1 : it->second;
+    }
+    const string& junctionId(int u) const { return junctionIds[u]; }
+
+    // Dijkstra over the CSR arrays with the chosen queue. Fills dist/parent and stops once
+    // 'dest' is settled; dest = -1 computes the whole shortest-path tree.
+    int dijkstra(int src, int dest, vector<int>& dist, vector<int>& parent, QueueKind queue = BINARY_HEAP) const {
+        switch (queue) {
+            case DIAL_BUCKETS: return runDijkstra<DialQueue>(src, dest, dist, parent);
+            case RADIX_HEAP: return runDijkstra<RadixHeapQueue>(src, dest, dist, parent);
+            default: return runDijkstra<BinaryHeapQueue>(src, dest, dist, parent);
+        }
+    }
+
+    // Same search as dijkstra() on a reusable workspace, for long-running servers that
+    // answer many queries. Optionally returns the junction sequence src ... dest.
+    int route(int src, int dest, SearchWorkspace& ws, vector<int>* path = nullptr) const {
+        ws.prepare(V);
+        ws.set(src, 0, -1);
+        ws.heap.push_back({0, src});
+        while (!ws.heap.empty()) {
+            pop_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+            auto [d, u] = ws.heap.back();
+            ws.heap.pop_back();
+            if (d > ws.get(u)) continue;
+            ws.settled++;
+            if (u == dest) break;
+            for (int e = offset[u]; e < offset[u + 1]; e++) {
+                int v = target[e], nd = d + weight[e];
+                if (nd < ws.get(v)) {
+                    ws.set(v, nd, u);
+                    ws.heap.push_back({nd, v});
+                    push_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+                }
+            }
+        }
+        int minutes = ws.get(dest);
+        if (path) ws.pathTo(dest, *path);
+        return minutes;
+    }
+
+    void shortestPath(int src, int dest) const {
+        vector<int> dist, parent;
+        dijkstra(src, dest, dist, parent);
+
+        vector<int> path;
+        if (dist[dest] != INT_MAX)
+            for (int v = dest; v != -1; v = parent[v])
+                path.push_back(v);
+        reverse(path.begin(), path.end());
+        printRoute(src, dest, dist[dest], path);
+    }
+
+    // Prints a route given as the junction sequence src ... dest.
+    void printRoute(int src, int dest, int minutes, const vector<int>& path) const {
+        if (minutes == INT_MAX) {
+            cout << "No path found from " << names[src] << " to " << names[dest] << endl;
             return;
         }
 
-        cout << "\nShortest distance from " << idToName[src] << " to " << idToName[dest] << " is: " << dist[dest] << " minutes\n";
+        cout << "\nShortest distance from " << names[src] << " to " << names[dest] << " is: " << minutes << " minutes\n";
 
         cout << "Path: ";
-        vector<int> path;
-        for (int v = dest; v != -1; v = parent[v])
-            path.push_back(v);
-        for (int i = path.size() - 1; i >= 0; i--)
-            cout << idToName[path[i]] << (i == 0 ? "\n" : " -> ");
+        for (size_t i = 0; i < path.size(); i++)
+            cout << names[path[i]] << (i + 1 == path.size() ? "\n" : " -> ");
+    }
+};
+
+// --- Contraction Hierarchy ---
+// Offline preprocessing contracts junctions one at a time, least important first, and adds
+// a shortcut road u-x whenever removing junction v would break the only shortest u-v-x
+// connection. A query then searches only "upward" (towards later-contracted junctions)
+// from both ends, which settles a few hundred junctions instead of a whole city.
+
+// Per-thread scratch space for a CH query. Arrays are never cleared: an entry is valid
+// only if its stamp equals the current version, so each query costs O(junctions touched).
+struct CHWorkspace {
+    vector<int> dist[2], parent[2], parentArc[2], stamp[2];
+    vector<pii> heap[2];
+    int version = 0;
+    int settled = 0;
+
+    void prepare(int V) {
+        if ((int)stamp[0].size() != V)
+            for (int d = 0; d < 2; d++) {
+                dist[d].assign(V, INT_MAX); parent[d].assign(V, -1);
+                parentArc[d].assign(V, -1); stamp[d].assign(V, 0);
+            }
+        if (++version == INT_MAX) {
+            for (int d = 0; d < 2; d++) fill(stamp[d].begin(), stamp[d].end(), 0);
+            version = 1;
+        }
+        settled = 0;
+    }
+    int get(int d, int v) const { return stamp[d][v] == version ? dist[d][v] : INT_MAX; }
+    void set(int d, int v, int value, int from, int arc) {
+        stamp[d][v] = version; dist[d][v] = value; parent[d][v] = from; parentArc[d][v] = arc;
     }
 };
 
-int main() {
-    // Node mapping
-    unordered_map<string, int> nameToId = {
-        {"N1",0}, {"N2",1}, {"N3",2}, {"N4",3}, {"N5",4}, {"N6",5},
-        {"N7",6}, {"N8",7}, {"N9",8}, {"N10",9}, {"N11",10}, {"N12",11},
-        {"N13",12}, {"N14",13}, {"N15",14}, {"N16",15}, {"N17",16}, {"N18",17}
+class ContractionHierarchy {
+    struct Arc {
+        int to, w;
+        int mid; // Junction a shortcut bypasses, -1 for an original road
     };
+    int V = 0;
+    vector<int> rank;     // Contraction order: higher rank = more important junction
+    vector<int> upOffset; // CSR of upward arcs, stored at the lower-ranked end
+    vector<Arc> upArcs;
 
-    unordered_map<int, string> idToName = {
-        {0,"Central Circle Junction"}, {1,"City Civic Center (CCC)"}, {2,"School Main Gate"},
-        {3,"University Junction"}, {4,"Residential Area North"}, {5,"Residential Area South"},
-        {6,"Hospital"}, {7,"Fire Station"}, {8,"Shopping District"},
-        {9,"Industrial Area Gate"}, {10,"IT & Tech Park"}, {11,"Airport Entrance"},
-        {12,"Airport Terminal"}, {13,"Forest Edge"}, {14,"Park & Lake"},
-        {15,"Bus Stand"}, {16,"Railway Station"}, {17,"Govt Service Center"}
+    // Bounded Dijkstra used during preprocessing to look for a path u -> x that avoids
+    // the junction being contracted and is no longer than the would-be shortcut.
+    struct WitnessSearch {
+        vector<int> dist, stamp, isTarget;
+        vector<pii> heap;
+        vector<int> targets;
+        int version = 0;
+        int get(int v) const { return stamp[v] == version ? dist[v] : INT_MAX; }
+
+        // Stops early once every junction in 'targets' has been settled.
+        void run(const vector<vector<Arc>>& adj, int src, int skip, int limit, int maxSettled,
+                 const vector<int>& targets) {
+            version++;
+            heap.clear();
+            int remaining = 0;
+            for (int x : targets)
+                if (isTarget[x] != version) { isTarget[x] = version; remaining++; }
+            stamp[src] = version; dist[src] = 0;
+            heap.push_back({0, src});
+            int settled = 0;
+            while (!heap.empty() && settled < maxSettled && remaining > 0) {
+                pop_heap(heap.begin(), heap.end(), greater<pii>());
+                auto [d, u] = heap.back();
+                heap.pop_back();
+                if (d > get(u)) continue;
+                if (d > limit) break;
+                settled++;
+                if (isTarget[u] == version) { isTarget[u] = 0; remaining--; }
+                for (const Arc& a : adj[u]) {
+                    if (a.to == skip) continue;
+                    int nd = d + a.w;
+                    if (nd < get(a.to) && nd <= limit) {
+                        stamp[a.to] = version; dist[a.to] = nd;
+                        heap.push_back({nd, a.to});
+                        push_heap(heap.begin(), heap.end(), greater<pii>());
+                    }
+                }
+            }
+        }
     };
 
-    CityGraph city(18);
-
-    // Add edges (time in minutes)
-    city.addRoad(0,1,4); city.addRoad(0,2,3); city.addRoad(0,8,3); city.addRoad(0,15,5);
-    city.addRoad(1,3,5); city.addRoad(1,6,7);
-    city.addRoad(2,4,4); city.addRoad(2,8,3);
-    city.addRoad(3,5,5); city.addRoad(3,10,8);
-    city.addRoad(4,6,6); city.addRoad(4,14,4);
-    city.addRoad(5,17,5); city.addRoad(5,14,3);
-    city.addRoad(6,7,2); city.addRoad(6,16,6);
-    city.addRoad(7,9,9);
-    city.addRoad(8,5,4); city.addRoad(8,15,3);
-    city.addRoad(9,10,7); city.addRoad(9,13,8);
-    city.addRoad(10,11,10);
-    city.addRoad(11,12,2);
-    city.addRoad(12,13,7);
-    city.addRoad(13,14,5);
-    city.addRoad(14,17,4);
-    city.addRoad(15,16,4);
-    city.addRoad(16,11,11);
+    static void addOrImprove(vector<Arc>& list, int to, int w, int mid) {
+        for (Arc& a : list)
+            if (a.to == to) {
+                if (w < a.w) { a.w = w; a.mid = mid; }
+                return;
+            }
+        list.push_back({to, w, mid});
+    }
+
+    // Counts (and, if 'apply', inserts) the shortcuts needed to contract v.
+    static int processJunction(vector<vector<Arc>>& adj, WitnessSearch& ws, int v, bool apply) {
+        const int maxSettled = apply ? 500 : 50;
+        const vector<Arc> nb = adj[v];
+        int shortcuts = 0;
+        for (size_t i = 0; i + 1 < nb.size(); i++) {
+            int maxVia = 0;
+            ws.targets.clear();
+            for (size_t j = i + 1; j < nb.size(); j++) {
+                maxVia = max(maxVia, nb[i].w + nb[j].w);
+                ws.targets.push_back(nb[j].to);
+            }
+            ws.run(adj, nb[i].to, v, maxVia, maxSettled, ws.targets);
+            for (size_t j = i + 1; j < nb.size(); j++) {
+                int via = nb[i].w + nb[j].w;
+                if (ws.get(nb[j].to) <= via) continue; // Witness path found
+                shortcuts++;
+                if (apply) {
+                    addOrImprove(adj[nb[i].to], nb[j].to, via, v);
+                    addOrImprove(adj[nb[j].to], nb[i].to, via, v);
+                }
+            }
+        }
+        return shortcuts;
+    }
+
+    int midOf(int lower, int higher) const {
+        for (int e = upOffset[lower]; e < upOffset[lower + 1]; e++)
+            if (upArcs[e].to == higher) return upArcs[e].mid;
+        return -1;
+    }
+
+    // Appends the original junctions on the (possibly shortcut) arc x-y, excluding x.
+    void unpack(int x, int y, int mid, vector<int>& out) const {
+        if (mid == -1) { out.push_back(y); return; }
+        unpack(x, mid, midOf(mid, x), out);
+        unpack(mid, y, midOf(mid, y), out);
+    }
+
+public:
+    int size() const { return V; }
+    long long arcCount() const { return upArcs.size(); }
+
+    void build(const CityGraph& g) {
+        V = g.size();
+        vector<vector<Arc>> adj(V);
+        for (int u = 0; u < V; u++)
+            for (int e = g.roadBegin(u); e < g.roadEnd(u); e++)
+                if (g.roadTo(e) != u) addOrImprove(adj[u], g.roadTo(e), g.roadTime(e), -1);
+
+        WitnessSearch ws;
+        ws.dist.assign(V, INT_MAX);
+        ws.stamp.assign(V, 0);
+        ws.isTarget.assign(V, 0);
+
+        // Importance = weighted edge difference + hierarchy depth (keeps the upward search
+        // spaces shallow). Priorities are re-evaluated lazily when popped.
+        vector<int> level(V, 0);
+        auto priority = [&](int v) {
+            return 4 * processJunction(adj, ws, v, false) - 2 * (int)adj[v].size() + level[v];
+        };
+        priority_queue<pii, vector<pii>, greater<pii>> order;
+        for (int v = 0; v < V; v++) order.push({priority(v), v});
+
+        rank.assign(V, -1);
+        vector<vector<Arc>> up(V);
+        int next = 0;
+        while (!order.empty()) {
+            int v = order.top().second;
+            order.pop();
+            if (rank[v] != -1) continue;
+            int p = priority(v);
+            if (!order.empty() && p > order.top().first) { order.push({p, v}); continue; }
+
+            processJunction(adj, ws, v, true);
+            rank[v] = next++;
+            up[v] = move(adj[v]);
+            adj[v].clear();
+            for (const Arc& a : up[v]) {
+                auto& list = adj[a.to];
+                for (size_t i = 0; i < list.size(); i++)
+                    if (list[i].to == v) { list[i] = list.back(); list.pop_back(); break; }
+                level[a.to] = max(level[a.to], level[v] + 1);
+            }
+            for (const Arc& a : up[v]) order.push({priority(a.to), a.to});
+        }
+
+        upOffset.assign(V + 1, 0);
+        for (int v = 0; v < V; v++) upOffset[v + 1] = upOffset[v] + up[v].size();
+        upArcs.clear();
+        upArcs.reserve(upOffset[V]);
+        for (int v = 0; v < V; v++) upArcs.insert(upArcs.end(), up[v].begin(), up[v].end());
+    }
+
+    // Binary layout: magic, V, arc count, rank[V], upOffset[V+1], upArcs[arcs].
+    bool save(const string& path) const {
+        FILE* fp = fopen(path.c_str(), "wb");
+        if (!fp) return false;
+        const char magic[8] = {'C', 'I', 'T', 'Y', 'C', 'H', '1', 0};
+        long long arcs = upArcs.size();
+        fwrite(magic, 1, 8, fp);
+        fwrite(&V, sizeof V, 1, fp);
+        fwrite(&arcs, sizeof arcs, 1, fp);
+        fwrite(rank.data(), sizeof(int), V, fp);
+        fwrite(upOffset.data(), sizeof(int), V + 1, fp);
+        fwrite(upArcs.data(), sizeof(Arc), arcs, fp);
+        return fclose(fp) == 0;
+    }
+
+    bool load(const string& path) {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (!fp) return false;
+        char magic[8];
+        long long arcs = 0;
+        bool ok = fread(magic, 1, 8, fp) == 8 && memcmp(magic, "CITYCH1", 8) == 0 &&
+                  fread(&V, sizeof V, 1, fp) == 1 && fread(&arcs, sizeof arcs, 1, fp) == 1;
+        if (ok) {
+            rank.resize(V); upOffset.resize(V + 1); upArcs.resize(arcs);
+            ok = fread(rank.data(), sizeof(int), V, fp) == (size_t)V &&
+                 fread(upOffset.data(), sizeof(int), V + 1, fp) == (size_t)V + 1 &&
+                 fread(upArcs.data(), sizeof(Arc), arcs, fp) == (size_t)arcs;
+        }
+        fclose(fp);
+        return ok;
+    }
+
+    // Bidirectional upward Dijkstra. Returns the travel time (INT_MAX if unreachable) and,
+    // if 'path' is given, the fully unpacked junction sequence src ... dest.
+    int query(int src, int dest, CHWorkspace& ws, vector<int>* path = nullptr) const {
+        ws.prepare(V);
+        for (int d = 0; d < 2; d++) ws.heap[d].clear();
+        ws.set(0, src, 0, -1, -1);
+        ws.set(1, dest, 0, -1, -1);
+        ws.heap[0].push_back({0, src});
+        ws.heap[1].push_back({0, dest});
+
+        int best = INT_MAX, meet = -1;
+        while (true) {
+            int d = -1;
+            for (int k = 0; k < 2; k++)
+                if (!ws.heap[k].empty() && ws.heap[k].front().first < best &&
+                    (d == -1 || ws.heap[k].front().first < ws.heap[d].front().first)) d = k;
+            if (d == -1) break;
+
+            auto& heap = ws.heap[d];
+            pop_heap(heap.begin(), heap.end(), greater<pii>());
+            auto [du, u] = heap.back();
+            heap.pop_back();
+            if (du > ws.get(d, u)) continue;
+            ws.settled++;
+
+            int other = ws.get(1 - d, u);
+            if (other != INT_MAX && du + other < best) { best = du + other; meet = u; }
+
+            // Stall-on-demand: roads are two-way, so an upward arc u-w also reaches u from
+            // the more important w. If that is shorter, u is not on any shortest upward path.
+            bool stalled = false;
+            for (int e = upOffset[u]; e < upOffset[u + 1] && !stalled; e++) {
+                int dw = ws.get(d, upArcs[e].to);
+                stalled = dw != INT_MAX && dw + upArcs[e].w < du;
+            }
+            if (stalled) continue;
+
+            for (int e = upOffset[u]; e < upOffset[u + 1]; e++) {
+                const Arc& a = upArcs[e];
+                int nd = du + a.w;
+                if (nd < ws.get(d, a.to)) {
+                    ws.set(d, a.to, nd, u, e);
+                    heap.push_back({nd, a.to});
+                    push_heap(heap.begin(), heap.end(), greater<pii>());
+                }
+            }
+        }
+
+        if (path) {
+            path->clear();
+            if (meet != -1) {
+                vector<int> chain; // src ... meet along forward parents
+                for (int v = meet; v != -1; v = ws.parent[0][v]) chain.push_back(v);
+                reverse(chain.begin(), chain.end());
+                path->push_back(src);
+                for (size_t i = 0; i + 1 < chain.size(); i++)
+                    unpack(chain[i], chain[i + 1], upArcs[ws.parentArc[0][chain[i + 1]]].mid, *path);
+                for (int v = meet; ws.parent[1][v] != -1; v = ws.parent[1][v])
+                    unpack(v, ws.parent[1][v], upArcs[ws.parentArc[1][v]].mid, *path);
+            }
+        }
+        return best;
+    }
+};
+
+// --- A* with landmarks (ALT) ---
+// A handful of well-spread landmark junctions are chosen offline and their travel times
+// to every junction stored in a binary table. By the triangle inequality,
+// |d(L, t) - d(L, v)| never overestimates d(v, t), so the largest such bound over all
+// landmarks is an admissible A* heuristic that steers the search towards the target.
+
+// Read-only memory mapping of a whole file (unmapped on destruction).
+class MappedFile {
+    void* base = MAP_FAILED;
+    size_t length = 0;
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { if (base != MAP_FAILED) munmap(base, length); }
+
+    bool open(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            length = st.st_size;
+            base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        return base != MAP_FAILED;
+    }
+    const char* data() const { return (const char*)base; }
+    size_t size() const { return length; }
+};
+
+class LandmarkTable {
+    // File layout: magic "CITYALT1", int32 V, int32 K, int32 bytes per entry (2 or 4),
+    // int32 landmark ids[K], then the table junction-major: entry [v * K + i] = d(L_i, v),
+    // all-ones for unreachable. 16-bit entries are used whenever every distance fits.
+    MappedFile file;
+    int V = 0, K = 0, width = 4;
+    const int* landmarks = nullptr;
+    const unsigned char* table = nullptr;
+
+    unsigned entry(int v, int i) const {
+        size_t at = (size_t)v * K + i;
+        if (width == 2) {
+            unsigned short x;
+            memcpy(&x, table + at * 2, 2);
+            return x == 0xFFFF ? UINT_MAX : x;
+        }
+        unsigned x;
+        memcpy(&x, table + at * 4, 4);
+        return x;
+    }
+
+public:
+    int size() const { return V; }
+    int count() const { return K; }
+
+    // Picks K landmarks by farthest-point selection (each new landmark is the junction
+    // farthest from all landmarks chosen so far) and writes their distance table to 'path'.
+    static bool build(const CityGraph& g, int K, const string& path) {
+        int V = g.size();
+        K = max(1, min(K, V));
+        vector<int> chosen, dist, parent;
+        vector<vector<int>> rows;
+        vector<int> nearest(V, INT_MAX);
+
+        g.dijkstra(0, -1, dist, parent, DIAL_BUCKETS);
+        int next = max_element(dist.begin(), dist.end(), [](int a, int b) {
+            return (a == INT_MAX ? -1 : a) < (b == INT_MAX ? -1 : b);
+        }) - dist.begin();
+        while ((int)chosen.size() < K) {
+            chosen.push_back(next);
+            g.dijkstra(next, -1, dist, parent, DIAL_BUCKETS);
+            rows.push_back(dist);
+            next = -1;
+            for (int v = 0; v < V; v++) {
+                nearest[v] = min(nearest[v], dist[v]);
+                // Unreached junctions (other components) make good landmarks too.
+                if (next == -1 || nearest[v] > nearest[next]) next = v;
+            }
+        }
+
+        unsigned maxFinite = 0;
+        for (auto& row : rows)
+            for (int d : row) if (d != INT_MAX) maxFinite = max(maxFinite, (unsigned)d);
+        int width = maxFinite < 0xFFFF ? 2 : 4;
+
+        FILE* fp = fopen(path.c_str(), "wb");
+        if (!fp) return false;
+        fwrite("CITYALT1", 1, 8, fp);
+        fwrite(&V, 4, 1, fp); fwrite(&K, 4, 1, fp); fwrite(&width, 4, 1, fp);
+        fwrite(chosen.data(), 4, K, fp);
+        vector<unsigned char> line((size_t)K * width);
+        for (int v = 0; v < V; v++) {
+            for (int i = 0; i < K; i++) {
+                int d = rows[i][v];
+                if (width == 2) { unsigned short x = d == INT_MAX ? 0xFFFF : d; memcpy(&line[i * 2], &x, 2); }
+                else { unsigned x = d == INT_MAX ? UINT_MAX : d; memcpy(&line[i * 4], &x, 4); }
+            }
+            fwrite(line.data(), 1, line.size(), fp);
+        }
+        return fclose(fp) == 0;
+    }
+
+    // Maps the table file; the OS pages it in lazily, so startup cost does not grow with V.
+    bool load(const string& path) {
+        if (!file.open(path) || file.size() < 20 || memcmp(file.data(), "CITYALT1", 8) != 0) return false;
+        memcpy(&V, file.data() + 8, 4);
+        memcpy(&K, file.data() + 12, 4);
+        memcpy(&width, file.data() + 16, 4);
+        if ((width != 2 && width != 4) || file.size() != 20 + (size_t)K * 4 + (size_t)V * K * width) return false;
+        landmarks = (const int*)(file.data() + 20);
+        table = (const unsigned char*)(file.data() + 20 + (size_t)K * 4);
+        return true;
+    }
+
+    // Lower bound on the travel time v -> target, using ws.targetDist from the query.
+    int lowerBound(int v, const SearchWorkspace& ws) const {
+        int h = 0;
+        for (int i = 0; i < K; i++) {
+            unsigned dt = ws.targetDist[i], dv = entry(v, i);
+            if (dt == UINT_MAX || dv == UINT_MAX) continue;
+            h = max(h, (int)(dt > dv ? dt - dv : dv - dt));
+        }
+        return h;
+    }
+
+    // A* from src to dest. With useHeuristic = false this is plain Dijkstra on the same
+    // workspace, which makes the settled-junction counts directly comparable.
+    int query(const CityGraph& g, int src, int dest, SearchWorkspace& ws, vector<int>* path = nullptr,
+              bool useHeuristic = true) const {
+        ws.prepare(V);
+        ws.targetDist.resize(K);
+        for (int i = 0; i < K; i++) ws.targetDist[i] = entry(dest, i);
+
+        auto h = [&](int v) {
+            if (!useHeuristic) return 0;
+            if (ws.boundStamp[v] != ws.version) { ws.boundStamp[v] = ws.version; ws.bound[v] = lowerBound(v, ws); }
+            return ws.bound[v];
+        };
+        ws.set(src, 0, -1);
+        ws.heap.push_back({h(src), src});
+        while (!ws.heap.empty()) {
+            pop_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+            auto [f, u] = ws.heap.back();
+            ws.heap.pop_back();
+            int du = ws.get(u);
+            if (f - h(u) > du) continue; // Stale entry
+            ws.settled++;
+            if (u == dest) break;
+
+            for (int e = g.roadBegin(u); e < g.roadEnd(u); e++) {
+                int v = g.roadTo(e), nd = du + g.roadTime(e);
+                if (nd < ws.get(v)) {
+                    ws.set(v, nd, u);
+                    ws.heap.push_back({nd + h(v), v});
+                    push_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+                }
+            }
+        }
+
+        int minutes = ws.get(dest);
+        if (path) ws.pathTo(dest, *path);
+        return minutes;
+    }
+};
+
+// --- Time-dependent travel times ---
+// Traffic data gives a road one travel time per 5-minute departure slot of the day (288
+// samples). Each sample row becomes a periodic piecewise-linear function: a breakpoint is
+// dropped when the line through its neighbours stays within a few seconds of every sample
+// it skips, so flat night hours collapse to one segment. Identical functions are stored once
+// and shared by every road that uses them; a road carries only a 4-byte profile id.
+//
+// Profiles CSV (one row per direction; roads without a row keep their constant time_min):
+//   source,target,profile
+//   N1,N2,4 4 4 4.2 ... (288 travel times in minutes, for departures 00:00, 00:05, ..., 23:55)
+
+const int DAY_SECONDS = 24 * 60 * 60;
+const int PROFILE_SLOTS = 288;
+const int SLOT_SECONDS = DAY_SECONDS / PROFILE_SLOTS;
+
+struct ProfilePoint {
+    uint16_t slot;    // Departure time as a 5-minute slot index, 0 .. 287
+    uint16_t seconds; // Travel time when leaving at that slot
+};
+
+class TrafficProfiles {
+    vector<ProfilePoint> points;    // Every distinct profile, back to back
+    vector<uint32_t> first{0};      // Profile p is points[first[p] .. first[p+1]-1]
+    vector<uint32_t> roadProfile;   // CSR road slot -> profile id
+    unordered_map<string, uint32_t> lookup; // Breakpoint bytes -> profile id
+    int toleranceSeconds;
+
+public:
+    explicit TrafficProfiles(int toleranceSeconds = 3) : toleranceSeconds(toleranceSeconds) {}
+
+    // Gives every road its constant CSV travel time (one breakpoint per distinct time).
+    void reset(const CityGraph& g) {
+        points.clear(); first.assign(1, 0); lookup.clear();
+        roadProfile.resize(g.roadCount() * 2);
+        vector<int> flat(PROFILE_SLOTS);
+        for (int e = 0; e < (int)roadProfile.size(); e++) {
+            fill(flat.begin(), flat.end(), g.roadTime(e) * 60);
+            roadProfile[e] = addProfile(flat);
+        }
+    }
+
+    // Compresses 288 travel times (seconds) into breakpoints and returns the id of the
+    // shared copy. Samples are first raised where needed so that leaving later never means
+    // arriving earlier (FIFO); the linear pieces between kept samples then keep that
+    // property, which is what makes the time-dependent Dijkstra below exact.
+    uint32_t addProfile(vector<int> s) {
+        for (int& x : s) x = min(max(x, 0), 65535);
+        for (bool raised = true; raised;) {
+            raised = false;
+            for (int i = 0; i < PROFILE_SLOTS; i++) {
+                int& next = s[(i + 1) % PROFILE_SLOTS];
+                if (next < s[i] - SLOT_SECONDS) { next = s[i] - SLOT_SECONDS; raised = true; }
+            }
+        }
+
+        // Greedy simplification over slots 0 .. 288, where slot 288 is slot 0 of the next day.
+        // [lo, hi] is the range of slopes from the anchor that pass within tolerance of every
+        // skipped sample, so each sample is examined once.
+        vector<ProfilePoint> kept{{0, (uint16_t)s[0]}};
+        auto at = [&](int i) { return s[i % PROFILE_SLOTS]; };
+        int anchor = 0;
+        double lo = -1e18, hi = 1e18;
+        for (int j = 1; j <= PROFILE_SLOTS; j++) {
+            double slope = (double)(at(j) - at(anchor)) / (j - anchor);
+            if (slope < lo || slope > hi) {
+                anchor = j - 1;
+                kept.push_back({(uint16_t)anchor, (uint16_t)s[anchor]});
+                lo = -1e18; hi = 1e18;
+            }
+            lo = max(lo, (double)(at(j) - toleranceSeconds - at(anchor)) / (j - anchor));
+            hi = min(hi, (double)(at(j) + toleranceSeconds - at(anchor)) / (j - anchor));
+        }
+
+        string key((const char*)kept.data(), kept.size() * sizeof(ProfilePoint));
+        auto [it, added] = lookup.emplace(move(key), (uint32_t)first.size() - 1);
+        if (added) {
+            points.insert(points.end(), kept.begin(), kept.end());
+            first.push_back(points.size());
+        }
+        return it->second;
+    }
+
+    void setRoadProfile(int e, uint32_t profile) { roadProfile[e] = profile; }
+
+    // Loads a profiles CSV (format above) on top of the constant CSV travel times.
+    bool loadFromCSV(const CityGraph& g, const string& path) {
+        CsvLineReader in(path);
+        if (!in.ok()) { cerr << "Could not open " << path << "\n"; return false; }
+        reset(g);
+
+        const char* line; size_t n;
+        const char* f[3]; size_t fl[3];
+        vector<int> samples;
+        long long skipped = 0;
+        in.next(line, n); // Skip header
+        while (in.next(line, n)) {
+            if (splitFields(line, n, f, fl, 3) < 3) continue;
+            int u = g.findJunction(string(f[0], fl[0])), v = g.findJunction(string(f[1], fl[1]));
+            samples.clear();
+            const char* p = f[2];
+            const char* end = f[2] + fl[2];
+            double minutes;
+            while (p < end) {
+                while (p < end && *p == ' ') p++;
+                if (p == end) break;
+                auto r = from_chars(p, end, minutes);
+                if (r.ec != errc()) break;
+                samples.push_back((int)(minutes * 60 + 0.5));
+                p = r.ptr;
+            }
+            bool matched = false;
+            if (u != -1 && v != -1 && samples.size() == PROFILE_SLOTS) {
+                uint32_t id = addProfile(samples);
+                for (int e = g.roadBegin(u); e < g.roadEnd(u); e++)
+                    if (g.roadTo(e) == v) { roadProfile[e] = id; matched = true; }
+            }
+            if (!matched) skipped++;
+        }
+        if (skipped)
+            cerr << "Warning: skipped " << skipped << " profile row(s) with unknown roads or not 288 samples.\n";
+        return true;
+    }
+
+    // Travel time in seconds over road slot e when entering it at 'when' (seconds since
+    // midnight of the departure day; later days wrap around).
+    int travelTime(int e, int when) const {
+        const ProfilePoint* p = points.data() + first[roadProfile[e]];
+        int n = first[roadProfile[e] + 1] - first[roadProfile[e]];
+        if (n == 1) return p[0].seconds;
+        int t = when % DAY_SECONDS;
+        int slot = t / SLOT_SECONDS;
+        int j = upper_bound(p, p + n, slot, [](int s, const ProfilePoint& q) { return s < q.slot; }) - p - 1;
+        int x0 = p[j].slot * SLOT_SECONDS, y0 = p[j].seconds;
+        int x1 = j + 1 < n ? p[j + 1].slot * SLOT_SECONDS : DAY_SECONDS;
+        int y1 = j + 1 < n ? p[j + 1].seconds : p[0].seconds;
+        return y0 + (int)((long long)(y1 - y0) * (t - x0) / (x1 - x0));
+    }
+
+    // Time-dependent Dijkstra: earliest arrival (seconds since midnight) at 'dest' when
+    // leaving 'src' at 'depart', or INT_MAX. Labels are arrival times; with FIFO roads the
+    // first time a junction is settled is its earliest possible arrival.
+    int query(const CityGraph& g, int src, int dest, int depart, SearchWorkspace& ws, vector<int>* path = nullptr) const {
+        ws.prepare(g.size());
+        ws.set(src, depart, -1);
+        ws.heap.push_back({depart, src});
+        while (!ws.heap.empty()) {
+            pop_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+            auto [t, u] = ws.heap.back();
+            ws.heap.pop_back();
+            if (t > ws.get(u)) continue;
+            ws.settled++;
+            if (u == dest) break;
+            for (int e = g.roadBegin(u); e < g.roadEnd(u); e++) {
+                int v = g.roadTo(e), arrive = t + travelTime(e, t);
+                if (arrive < ws.get(v)) {
+                    ws.set(v, arrive, u);
+                    ws.heap.push_back({arrive, v});
+                    push_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+                }
+            }
+        }
+        int arrival = ws.get(dest);
+        if (path) ws.pathTo(dest, *path);
+        return arrival;
+    }
+
+    int profileCount() const { return first.size() - 1; }
+    long long pointCount() const { return points.size(); }
+    long long bytes() const {
+        return points.size() * sizeof(ProfilePoint) + first.size() * sizeof(uint32_t) + roadProfile.size() * sizeof(uint32_t);
+    }
+};
+
+// Synthetic 24h traffic: free-flow at night plus morning (08:30) and evening (17:45) peaks.
+// 'kind' selects the pattern: 0 none, 1 morning only, 2 evening only, 3 both, 4 heavy both.
+void rushHourSamples(int baseMinutes, int kind, vector<int>& samples) {
+    static const double morning[5] = {0, 0.8, 0, 0.6, 1.5}, evening[5] = {0, 0, 0.7, 0.6, 1.2};
+    samples.resize(PROFILE_SLOTS);
+    for (int i = 0; i < PROFILE_SLOTS; i++) {
+        double h = i * SLOT_SECONDS / 3600.0;
+        double load = morning[kind] * exp(-(h - 8.5) * (h - 8.5) / 2) + evening[kind] * exp(-(h - 17.75) * (h - 17.75) / 3);
+        samples[i] = (int)(baseMinutes * 60 * (1 + load) + 0.5);
+    }
+}
+
+// Gives every road slot of g a random rush-hour pattern; kinds[e] records the choice.
+void synthesizeTraffic(const CityGraph& g, TrafficProfiles& traffic, unsigned seed, vector<uint8_t>* kinds = nullptr) {
+    traffic.reset(g);
+    mt19937 rng(seed);
+    discrete_distribution<int> pickKind({40, 20, 20, 15, 5});
+    vector<int> samples;
+    if (kinds) kinds->resize(g.roadCount() * 2);
+    for (int e = 0; e < g.roadCount() * 2; e++) {
+        int kind = pickKind(rng);
+        if (kinds) (*kinds)[e] = kind;
+        rushHourSamples(g.roadTime(e), kind, samples);
+        traffic.setRoadProfile(e, traffic.addProfile(samples));
+    }
+}
+
+// "08:15" -> seconds since midnight, or -1.
+int parseClock(const string& text) {
+    int h, m;
+    char colon;
+    istringstream in(text);
+    if (!(in >> h >> colon >> m) || colon != ':' || h < 0 || h > 23 || m < 0 || m > 59) return -1;
+    return (h * 60 + m) * 60;
+}
+
+string formatClock(int seconds) {
+    char buf[16];
+    snprintf(buf, sizeof buf, "%02d:%02d", seconds / 3600 % 24, seconds / 60 % 60);
+    return buf;
+}
+
+// --- Alternative routes (via-node / plateau method) ---
+// One search from the source and one from the destination, each stopped at (1 + maxStretch)
+// times the optimum, give every junction v a candidate route src -> v -> dest made of the two
+// tree paths. Roads that lie in both trees form "plateaus": stretches that are shortest
+// paths from both ends, so a candidate whose plateau is long is a sensible detour rather
+// than a zig-zag. All junctions of one plateau give the same route, so each plateau is
+// tried once, best (length - plateau) first. A candidate is accepted if it is loopless,
+// not much longer than the optimum and does not share too much road with routes already
+// chosen. The first route is always the shortest path.
+
+struct AlternativeRoute {
+    int minutes;
+    vector<int> path; // src ... dest
+};
+
+class AlternativeRouteFinder {
+    double maxStretch, maxSharing, minPlateau;
+    SearchWorkspace forward, backward;
+    vector<int> plateauStart, onRoute;
+    int onRouteVersion = 0;
+
+    // Dijkstra from src until the next key exceeds 'radius'. If 'dest' is given, the radius
+    // is set to (1 + maxStretch) times its distance once it is settled.
+    void growTree(const CityGraph& g, int src, int dest, int& radius, SearchWorkspace& ws, vector<int>& order) const {
+        ws.prepare(g.size());
+        ws.set(src, 0, -1);
+        ws.heap.push_back({0, src});
+        while (!ws.heap.empty()) {
+            pop_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+            auto [d, u] = ws.heap.back();
+            ws.heap.pop_back();
+            if (d > ws.get(u)) continue;
+            if (d > radius) break;
+            ws.settled++;
+            order.push_back(u);
+            if (u == dest) radius = d + (int)(d * maxStretch);
+            for (int e = g.roadBegin(u); e < g.roadEnd(u); e++) {
+                int v = g.roadTo(e), nd = d + g.roadTime(e);
+                if (nd < ws.get(v)) {
+                    ws.set(v, nd, u);
+                    ws.heap.push_back({nd, v});
+                    push_heap(ws.heap.begin(), ws.heap.end(), greater<pii>());
+                }
+            }
+        }
+    }
+
+    static long long roadKey(int u, int v) { return (long long)min(u, v) << 32 | (unsigned)max(u, v); }
+
+public:
+    AlternativeRouteFinder(double maxStretch = 0.25, double maxSharing = 0.8, double minPlateau = 0.2)
+        : maxStretch(maxStretch), maxSharing(maxSharing), minPlateau(minPlateau) {}
+
+    // Fills 'routes' with up to k routes, shortest first; returns how many were found.
+    int find(const CityGraph& g, int src, int dest, int k, vector<AlternativeRoute>& routes) {
+        routes.clear();
+        if (k <= 0) return 0;
+        vector<int> settledF, settledB;
+        int limit = INT_MAX;
+        growTree(g, src, dest, limit, forward, settledF);
+        int best = forward.get(dest);
+        if (best == INT_MAX) return 0;
+        growTree(g, dest, -1, limit, backward, settledB);
+
+        // Plateaus: walk junctions in forward-distance order so a junction's tree parent is
+        // labelled before it.
+        if ((int)plateauStart.size() != g.size()) { plateauStart.assign(g.size(), -1); onRoute.assign(g.size(), 0); }
+        struct Plateau { int start, end, total; };
+        vector<Plateau> plateaus;
+        vector<int> groupOf;
+        unordered_map<int, int> group; // plateau start -> index in plateaus
+        for (int v : settledF) {
+            int dB = backward.get(v);
+            if (dB == INT_MAX || forward.get(v) + dB > limit) continue;
+            int u = forward.parent[v];
+            bool shared = u != -1 && backward.get(u) != INT_MAX && backward.parent[u] == v && plateauStart[u] != -1 &&
+                          forward.get(u) + backward.get(u) == forward.get(v) + dB;
+            plateauStart[v] = shared ? plateauStart[u] : v;
+            auto [it, added] = group.emplace(plateauStart[v], plateaus.size());
+            if (added) plateaus.push_back({v, v, forward.get(v) + dB});
+            else plateaus[it->second].end = v;
+        }
+        for (int v : settledF) plateauStart[v] = -1;
+
+        // The longest plateau of optimal length goes first, so route 0 is a shortest path
+        // even when ties split it over several plateaus.
+        auto plateauLength = [&](const Plateau& p) { return forward.get(p.end) - forward.get(p.start); };
+        auto score = [&](const Plateau& p) { return p.total == best ? INT_MIN + p.total - plateauLength(p) : p.total - plateauLength(p); };
+        sort(plateaus.begin(), plateaus.end(), [&](const Plateau& a, const Plateau& b) { return score(a) < score(b); });
+
+        vector<unordered_map<long long, int>> used; // Roads of each accepted route -> minutes
+        vector<int> path;
+        for (const Plateau& p : plateaus) {
+            if ((int)routes.size() == k) break;
+            if (!routes.empty() && plateauLength(p) < minPlateau * best) continue;
+
+            // src -> plateau start -> plateau end -> dest, rejecting routes that revisit a junction.
+            path.clear();
+            for (int v = p.end; v != -1; v = forward.parent[v]) path.push_back(v);
+            reverse(path.begin(), path.end());
+            for (int v = backward.parent[p.end]; v != -1; v = backward.parent[v]) path.push_back(v);
+            if (++onRouteVersion == INT_MAX) { fill(onRoute.begin(), onRoute.end(), 0); onRouteVersion = 1; }
+            bool loopless = true;
+            for (int v : path) {
+                if (onRoute[v] == onRouteVersion) { loopless = false; break; }
+                onRoute[v] = onRouteVersion;
+            }
+            if (!loopless) continue;
+
+            bool distinct = true;
+            for (auto& roads : used) {
+                long long common = 0;
+                for (size_t i = 0; i + 1 < path.size(); i++) {
+                    auto it = roads.find(roadKey(path[i], path[i + 1]));
+                    if (it != roads.end()) common += it->second;
+                }
+                if (common > maxSharing * best) { distinct = false; break; }
+            }
+            if (!distinct) continue;
+
+            unordered_map<long long, int> roads;
+            for (size_t i = 0; i + 1 < path.size(); i++)
+                roads[roadKey(path[i], path[i + 1])] = g.directTime(path[i], path[i + 1]);
+            used.push_back(move(roads));
+            routes.push_back({p.total, path});
+        }
+        return routes.size();
+    }
+};
+
+// --- Routing daemon ---
+// Loads the map (and optional CH / ALT data) once, then answers newline-delimited JSON
+// requests such as
+//   {"id": 7, "from": "Hospital", "to": "Airport Terminal"}
+// with one JSON line each:
+//   {"id":7,"minutes":19,"path":["Hospital","Railway Station",...]}
+// Requests are read from stdin or from clients of a Unix socket and answered by a fixed
+// pool of workers, each owning its own search workspaces. Responses carry the request id
+// and may come back out of order.
+
+// The four hex digits of a \u escape starting at line[at], or -1 if they are not there.
+int jsonHex4(const string& line, size_t at) {
+    int code = 0;
+    if (at + 4 > line.size()) return -1;
+    const char* hex = line.data() + at;
+    auto res = from_chars(hex, hex + 4, code, 16);
+    return res.ec == errc() && res.ptr == hex + 4 ? code : -1;
+}
+
+void appendUtf8(string& out, int code) {
+    if (code < 0x80) out += (char)code;
+    else if (code < 0x800) { out += (char)(0xC0 | code >> 6); out += (char)(0x80 | (code & 0x3F)); }
+    else if (code < 0x10000) {
+        out += (char)(0xE0 | code >> 12); out += (char)(0x80 | (code >> 6 & 0x3F)); out += (char)(0x80 | (code & 0x3F));
+    } else {
+        out += (char)(0xF0 | code >> 18); out += (char)(0x80 | (code >> 12 & 0x3F));
+        out += (char)(0x80 | (code >> 6 & 0x3F)); out += (char)(0x80 | (code & 0x3F));
+    }
+}
+
+// Returns the value of "key" in a flat JSON object: the unescaped text of a string, or the
+// raw token of a number/literal. Nested objects and arrays are not supported. A string with
+// an invalid escape (including an unpaired \u surrogate) is not returned, and *malformed is
+// set instead.
+bool jsonField(const string& line, const string& key, string& out, bool* isString = nullptr,
+               bool* malformed = nullptr) {
+    string quoted = "\"" + key + "\"";
+    size_t at = 0;
+    while ((at = line.find(quoted, at)) != string::npos) {
+        size_t p = at + quoted.size();
+        while (p < line.size() && isspace((unsigned char)line[p])) p++;
+        if (p < line.size() && line[p] == ':') { at = p + 1; break; }
+        at = p;
+    }
+    if (at == string::npos) return false;
+    while (at < line.size() && isspace((unsigned char)line[at])) at++;
+    out.clear();
+    if (at < line.size() && line[at] == '"') {
+        if (isString) *isString = true;
+        for (size_t p = at + 1; p < line.size(); p++) {
+            char c = line[p];
+            if (c == '"') return true;
+            if (c == '\\' && p + 1 < line.size()) {
+                switch (c = line[++p]) {
+                    case '"': case '\\': case '/': break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'n': c = '\n'; break;
+                    case 'r': c = '\r'; break;
+                    case 't': c = '\t'; break;
+                    case 'u': {
+                        int code = jsonHex4(line, p + 1);
+                        p += 4;
+                        if (code >= 0xD800 && code < 0xDC00) { // High surrogate: needs its low half next
+                            int low = line.compare(p + 1, 2, "\\u") == 0 ? jsonHex4(line, p + 3) : -1;
+                            if (low < 0xDC00 || low >= 0xE000) code = -1;
+                            else { code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00); p += 6; }
+                        } else if (code >= 0xDC00 && code < 0xE000) code = -1; // Lone low surrogate
+                        if (code < 0) {
+                            if (malformed) *malformed = true;
+                            return false;
+                        }
+                        appendUtf8(out, code);
+                        continue;
+                    }
+                    default: // Not a JSON escape
+                        if (malformed) *malformed = true;
+                        return false;
+                }
+            }
+            out += c;
+        }
+        return false; // Unterminated string
+    }
+    if (isString) *isString = false;
+    size_t end = line.find_first_of(",}", at);
+    out = line.substr(at, end == string::npos ? string::npos : end - at);
+    while (!out.empty() && isspace((unsigned char)out.back())) out.pop_back();
+    return !out.empty();
+}
+
+void appendJsonString(string& out, const string& s) {
+    out += '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if (c < 0x20) { char esc[8]; snprintf(esc, sizeof esc, "\\u%04x", c); out += esc; }
+        else out += c;
+    }
+    out += '"';
+}
+
+// Buffered line reader over a file descriptor (stdin or a socket).
+class FdLineReader {
+    int fd;
+    char buf[1 << 16];
+    size_t pos = 0, len = 0;
+public:
+    explicit FdLineReader(int fd) : fd(fd) {}
+    bool next(string& line) {
+        line.clear();
+        while (true) {
+            if (pos == len) {
+                ssize_t n = ::read(fd, buf, sizeof buf);
+                if (n <= 0) return !line.empty();
+                pos = 0; len = n;
+            }
+            const char* start = buf + pos;
+            const char* nl = (const char*)memchr(start, '\n', len - pos);
+            size_t k = nl ? nl - start : len - pos;
+            line.append(start, k);
+            pos += k + (nl ? 1 : 0);
+            if (nl) return true;
+        }
+    }
+};
+
+class RouteServer {
+    // One client stream; workers serialise their writes to it.
+    struct Connection {
+        int fd;
+        bool socket;
+        mutex writeLock;
+        Connection(int fd, bool socket) : fd(fd), socket(socket) {}
+        ~Connection() { if (socket) ::close(fd); }
+        void send(const string& text) {
+            lock_guard<mutex> lock(writeLock);
+            for (size_t done = 0; done < text.size();) {
+                ssize_t n = socket ? ::send(fd, text.data() + done, text.size() - done, MSG_NOSIGNAL)
+                                   : ::write(fd, text.data() + done, text.size() - done);
+                if (n <= 0) return; // Client went away
+                done += n;
+            }
+        }
+    };
+    struct Job {
+        string request;
+        shared_ptr<Connection> client;
+    };
+
+    const CityGraph& city;
+    const ContractionHierarchy* ch;
+    const LandmarkTable* alt;
+    // Readers stop taking lines off their socket while this many requests wait, so a client
+    // that sends faster than the workers answer cannot grow the queue without bound.
+    static const size_t MAX_QUEUED = 4096;
+    deque<Job> jobs;
+    mutex jobsLock;
+    condition_variable jobsReady, jobsRoom;
+    bool stopping = false;
+    vector<thread> workers;
+    atomic<int> listenFd{-1};
+
+    string handle(const string& request, SearchWorkspace& ws, CHWorkspace& chWs, vector<int>& path) const {
+        string id, from, to;
+        bool idIsString = false, malformed = false;
+        string out = "{\"id\":";
+        if (jsonField(request, "id", id, &idIsString, &malformed)) {
+            if (idIsString) appendJsonString(out, id); else out += id;
+        } else {
+            out += "null";
+        }
+        int src = jsonField(request, "from", from, nullptr, &malformed) ? city.findPlace(from) : -1;
+        int dest = jsonField(request, "to", to, nullptr, &malformed) ? city.findPlace(to) : -1;
+        if (malformed) {
+            out += ",\"error\":\"malformed request\"}\n";
+            return out;
+        }
+        if (src == -1 || dest == -1) {
+            out += ",\"error\":\"unknown place\"}\n";
+            return out;
+        }
+
+        int minutes = ch ? ch->query(src, dest, chWs, &path)
+                    : alt ? alt->query(city, src, dest, ws, &path)
+                    : city.route(src, dest, ws, &path);
+        if (minutes == INT_MAX) {
+            out += ",\"error\":\"no path\"}\n";
+            return out;
+        }
+        out += ",\"minutes\":" + to_string(minutes) + ",\"path\":[";
+        for (size_t i = 0; i < path.size(); i++) {
+            if (i) out += ',';
+            appendJsonString(out, city.placeName(path[i]));
+        }
+        out += "]}\n";
+        return out;
+    }
+
+    void workerLoop() {
+        SearchWorkspace ws;
+        CHWorkspace chWs;
+        vector<int> path;
+        while (true) {
+            Job job;
+            {
+                unique_lock<mutex> lock(jobsLock);
+                jobsReady.wait(lock, [&] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return; // Stopping and fully drained
+                job = move(jobs.front());
+                jobs.pop_front();
+            }
+            jobsRoom.notify_one();
+            job.client->send(handle(job.request, ws, chWs, path));
+        }
+    }
+
+    void readRequests(int fd, shared_ptr<Connection> client) {
+        FdLineReader reader(fd);
+        string line;
+        while (reader.next(line)) {
+            if (line.find_first_not_of(" \t\r") == string::npos) continue;
+            {
+                unique_lock<mutex> lock(jobsLock);
+                jobsRoom.wait(lock, [&] { return jobs.size() < MAX_QUEUED; });
+                jobs.push_back({line, client});
+            }
+            jobsReady.notify_one();
+        }
+    }
+
+public:
+    RouteServer(const CityGraph& city, const ContractionHierarchy* ch, const LandmarkTable* alt, int threads)
+        : city(city), ch(ch), alt(alt) {
+        for (int t = 0; t < max(1, threads); t++) workers.emplace_back([this] { workerLoop(); });
+    }
+
+    // Finishes every queued request, then stops the workers.
+    ~RouteServer() {
+        {
+            lock_guard<mutex> lock(jobsLock);
+            stopping = true;
+        }
+        jobsReady.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    // Serves requests from stdin until EOF; answers go to stdout.
+    void serveStdio() {
+        readRequests(STDIN_FILENO, make_shared<Connection>(STDOUT_FILENO, false));
+    }
+
+    // Accepts clients on a Unix socket until stop() is called, one reader thread per client.
+    // Readers of clients that have disconnected are joined on the next accept, so a long-running
+    // daemon only holds threads for its open connections.
+    bool serveSocket(const string& path) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (fd < 0 || path.size() >= sizeof addr.sun_path) return false;
+        strcpy(addr.sun_path, path.c_str());
+        ::unlink(path.c_str());
+        if (::bind(fd, (sockaddr*)&addr, sizeof addr) < 0 || ::listen(fd, 128) < 0) {
+            ::close(fd);
+            return false;
+        }
+        listenFd = fd;
+        struct Reader {
+            thread worker;
+            shared_ptr<atomic<bool>> done;
+        };
+        vector<Reader> readers;
+        while (true) {
+            int client = ::accept(fd, nullptr, nullptr);
+            if (client < 0) {
+                if (errno == EINTR) continue;
+                break; // stop() shut the listening socket down
+            }
+            for (size_t i = 0; i < readers.size();) {
+                if (readers[i].done->load()) {
+                    readers[i].worker.join();
+                    readers[i] = move(readers.back());
+                    readers.pop_back();
+                } else {
+                    i++;
+                }
+            }
+            auto done = make_shared<atomic<bool>>(false);
+            readers.push_back({thread([this, client, done] {
+                readRequests(client, make_shared<Connection>(client, true));
+                *done = true;
+            }), done});
+        }
+        for (auto& r : readers) r.worker.join();
+        ::close(fd);
+        ::unlink(path.c_str());
+        return true;
+    }
+
+    void stop() {
+        int fd = listenFd.exchange(-1);
+        if (fd >= 0) ::shutdown(fd, SHUT_RDWR);
+    }
+};
+
+// --- Benchmark: CSR vs the previous adjacency-of-vectors layout ---
+
+// The layout CityGraph used before the CSR rewrite, loaded the straightforward way
+// (getline + stringstream, one push_back per road end). Kept only for comparison.
+struct AdjacencyGraph {
+    int V = 0;
+    vector<vector<pii>> adj;
+
+    void load(const string& nodesPath, const string& edgesPath) {
+        unordered_map<string, int> nodeId;
+        ifstream nodes(nodesPath), edges(edgesPath);
+        string line, id, name, from, to, km, mins;
+        getline(nodes, line);
+        while (getline(nodes, line)) {
+            stringstream ss(line);
+            getline(ss, id, ',');
+            getline(ss, name);
+            nodeId[id] = V++;
+        }
+        adj.resize(V);
+        getline(edges, line);
+        while (getline(edges, line)) {
+            stringstream ss(line);
+            getline(ss, from, ','); getline(ss, to, ','); getline(ss, km, ','); getline(ss, mins);
+            int u = nodeId[from], v = nodeId[to], w = stoi(mins);
+            adj[u].push_back({v, w});
+            adj[v].push_back({u, w});
+        }
+    }
+
+    int dijkstra(int src, int dest, vector<int>& dist, vector<int>& parent) const {
+        dist.assign(V, INT_MAX);
+        parent.assign(V, -1);
+        priority_queue<pii, vector<pii>, greater<pii>> pq;
+        dist[src] = 0;
+        pq.push({0, src});
+        while (!pq.empty()) {
+            int u = pq.top().second;
+            int d = pq.top().first;
+            pq.pop();
+            if (d > dist[u]) continue;
+            if (u == dest) break;
+            for (auto edge : adj[u]) {
+                int v = edge.first, w = edge.second;
+                if (d + w < dist[v]) {
+                    dist[v] = d + w;
+                    parent[v] = u;
+                    pq.push({dist[v], v});
+                }
+            }
+        }
+        return dist[dest];
+    }
+};
+
+// Generates a rows x cols grid city: every junction is linked to its right and lower
+// neighbour by a road of 1..maxMinutes minutes.
+void gridRoads(int rows, int cols, int maxMinutes, unsigned seed, vector<int>& eu, vector<int>& ev, vector<int>& ew) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> minutes(1, maxMinutes);
+    eu.clear(); ev.clear(); ew.clear();
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            int id = r * cols + c;
+            if (c + 1 < cols) { eu.push_back(id); ev.push_back(id + 1); ew.push_back(minutes(rng)); }
+            if (r + 1 < rows) { eu.push_back(id); ev.push_back(id + cols); ew.push_back(minutes(rng)); }
+        }
+    }
+}
+
+// Writes the 1-15 minute grid city in the same CSV format as nodes.csv / edges.csv.
+void writeGridCity(int rows, int cols, const string& nodesPath, const string& edgesPath, unsigned seed) {
+    vector<int> eu, ev, ew;
+    gridRoads(rows, cols, 15, seed, eu, ev, ew);
+    FILE* nf = fopen(nodesPath.c_str(), "w");
+    FILE* ef = fopen(edgesPath.c_str(), "w");
+    fprintf(nf, "node_id,name\n");
+    fprintf(ef, "source,target,distance_km,time_min\n");
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++)
+            fprintf(nf, "N%d,Junction %d-%d\n", r * cols + c + 1, r, c);
+    for (size_t i = 0; i < eu.size(); i++)
+        fprintf(ef, "N%d,N%d,%.1f,%d\n", eu[i] + 1, ev[i] + 1, ew[i] * 0.3, ew[i]);
+    fclose(nf);
+    fclose(ef);
+}
+
+double msSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+int runBenchmark(int rows, int cols, int queries) {
+    const string nodesPath = "/tmp/city_bench_nodes.csv";
+    const string edgesPath = "/tmp/city_bench_edges.csv";
+    cout << "Generating " << rows << "x" << cols << " grid city ("
+         << (long long)rows * cols << " junctions)...\n";
+    writeGridCity(rows, cols, nodesPath, edgesPath, 42);
+
+    auto t0 = chrono::steady_clock::now();
+    CityGraph csr;
+    if (!csr.loadFromCSV(nodesPath, edgesPath)) return 1;
+    double csrLoad = msSince(t0);
+
+    t0 = chrono::steady_clock::now();
+    AdjacencyGraph adj;
+    adj.load(nodesPath, edgesPath);
+    double adjLoad = msSince(t0);
+
+    mt19937 rng(7);
+    uniform_int_distribution<int> pick(0, csr.size() - 1);
+    vector<pii> pairs(queries);
+    for (auto& p : pairs) p = {pick(rng), pick(rng)};
+
+    vector<int> dist, parent;
+    long long checksumCsr = 0, checksumAdj = 0;
+    t0 = chrono::steady_clock::now();
+    for (auto& p : pairs) checksumCsr += csr.dijkstra(p.first, p.second, dist, parent);
+    double csrQuery = msSince(t0) / queries;
+
+    t0 = chrono::steady_clock::now();
+    for (auto& p : pairs) checksumAdj += adj.dijkstra(p.first, p.second, dist, parent);
+    double adjQuery = msSince(t0) / queries;
+
+    printf("\n%-22s %14s %14s\n", "layout", "load (ms)", "query (ms)");
+    printf("%-22s %14.1f %14.3f\n", "adjacency-of-vectors", adjLoad, adjQuery);
+    printf("%-22s %14.1f %14.3f\n", "CSR", csrLoad, csrQuery);
+    printf("\n%d random queries, distance checksum %s (%lld)\n", queries,
+           checksumCsr == checksumAdj ? "matches" : "MISMATCH", checksumCsr);
+
+    remove(nodesPath.c_str());
+    remove(edgesPath.c_str());
+    return checksumCsr == checksumAdj ? 0 : 1;
+}
+
+// Checks that 'path' is a real road sequence src ... dest whose travel times add up to 'minutes'.
+bool validRoute(const CityGraph& g, int src, int dest, int minutes, const vector<int>& path) {
+    if (minutes == INT_MAX) return path.empty();
+    if (path.empty() || path.front() != src || path.back() != dest) return false;
+    long long total = 0;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        int w = g.directTime(path[i], path[i + 1]);
+        if (w < 0) return false;
+        total += w;
+    }
+    return total == minutes;
+}
+
+int runCHBenchmark(int rows, int cols, int queries) {
+    const string nodesPath = "/tmp/city_bench_nodes.csv";
+    const string edgesPath = "/tmp/city_bench_edges.csv";
+    const string chPath = "/tmp/city_bench.ch";
+    cout << "Generating " << rows << "x" << cols << " grid city ("
+         << (long long)rows * cols << " junctions)...\n";
+    writeGridCity(rows, cols, nodesPath, edgesPath, 42);
+
+    CityGraph city;
+    if (!city.loadFromCSV(nodesPath, edgesPath)) return 1;
+
+    auto t0 = chrono::steady_clock::now();
+    ContractionHierarchy built;
+    built.build(city);
+    double buildMs = msSince(t0);
+    built.save(chPath);
+
+    t0 = chrono::steady_clock::now();
+    ContractionHierarchy ch;
+    if (!ch.load(chPath)) { cerr << "Could not reload " << chPath << "\n"; return 1; }
+    double loadMs = msSince(t0);
+
+    mt19937 rng(7);
+    uniform_int_distribution<int> pick(0, city.size() - 1);
+    vector<pii> pairs(queries);
+    for (auto& p : pairs) p = {pick(rng), pick(rng)};
+
+    vector<int> dist, parent, path;
+    vector<int> expected(queries);
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) expected[i] = city.dijkstra(pairs[i].first, pairs[i].second, dist, parent);
+    double dijkstraQuery = msSince(t0) / queries;
+
+    CHWorkspace ws;
+    long long settled = 0;
+    int mismatches = 0;
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        if (ch.query(pairs[i].first, pairs[i].second, ws) != expected[i]) mismatches++;
+        settled += ws.settled;
+    }
+    double chQuery = msSince(t0) / queries;
+
+    // Unpacked paths are checked separately so unpacking does not skew the timing above.
+    for (int i = 0; i < queries; i++) {
+        int d = ch.query(pairs[i].first, pairs[i].second, ws, &path);
+        if (!validRoute(city, pairs[i].first, pairs[i].second, d, path)) mismatches++;
+    }
+
+    printf("\nPreprocessing: %.1f ms, %lld upward arcs (%lld roads), reload %.1f ms\n",
+           buildMs, ch.arcCount(), city.roadCount(), loadMs);
+    printf("%-22s %14s\n", "engine", "query (ms)");
+    printf("%-22s %14.3f\n", "Dijkstra", dijkstraQuery);
+    printf("%-22s %14.4f   (%.0f junctions settled per query)\n", "Contraction Hierarchy",
+           chQuery, (double)settled / queries);
+    printf("\n%d random queries, %d mismatch(es) against Dijkstra\n", queries, mismatches);
+
+    remove(nodesPath.c_str());
+    remove(edgesPath.c_str());
+    remove(chPath.c_str());
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Full-city Dijkstra with each queue, over several grid sizes and road-time ranges.
+int runQueueBenchmark(int queries) {
+    const int sides[] = {100, 300, 1000};
+    const int ranges[] = {15, 100, 1000};
+    const char* labels[] = {"priority_queue", "Dial buckets", "radix heap"};
+    int mismatches = 0;
+
+    printf("%-12s %-10s %16s %16s %16s\n", "junctions", "max min", labels[0], labels[1], labels[2]);
+    for (int side : sides) {
+        for (int range : ranges) {
+            vector<int> eu, ev, ew;
+            gridRoads(side, side, range, 42, eu, ev, ew);
+            CityGraph city;
+            city.assignRoads(side * side, eu, ev, ew);
+
+            mt19937 rng(7);
+            uniform_int_distribution<int> pick(0, city.size() - 1);
+            vector<int> sources(queries);
+            for (int& s : sources) s = pick(rng);
+
+            vector<int> dist, parent;
+            double ms[3];
+            long long checksum[3] = {0, 0, 0};
+            for (int q = 0; q < 3; q++) {
+                auto t0 = chrono::steady_clock::now();
+                for (int s : sources) {
+                    city.dijkstra(s, -1, dist, parent, (QueueKind)q);
+                    for (int d : dist) checksum[q] += d;
+                }
+                ms[q] = msSince(t0) / queries;
+            }
+            if (checksum[1] != checksum[0] || checksum[2] != checksum[0]) mismatches++;
+            printf("%-12d %-10d %13.3f ms %13.3f ms %13.3f ms\n", city.size(), range, ms[0], ms[1], ms[2]);
+        }
+    }
+    printf("\n%d configuration(s) with distance mismatches\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+int runAltBenchmark(int rows, int cols, int queries, int landmarks) {
+    const string altPath = "/tmp/city_bench.alt";
+    vector<int> eu, ev, ew;
+    gridRoads(rows, cols, 15, 42, eu, ev, ew);
+    CityGraph city;
+    city.assignRoads(rows * cols, eu, ev, ew);
+    printf("Grid city: %d junctions, %d landmarks\n", city.size(), landmarks);
+
+    auto t0 = chrono::steady_clock::now();
+    if (!LandmarkTable::build(city, landmarks, altPath)) { cerr << "Could not write " << altPath << "\n"; return 1; }
+    double buildMs = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    LandmarkTable alt;
+    if (!alt.load(altPath)) { cerr << "Could not map " << altPath << "\n"; return 1; }
+    double mapMs = msSince(t0);
+    printf("Preprocessing: %.1f ms, memory-mapped in %.3f ms\n\n", buildMs, mapMs);
+
+    // Random pairs plus nearby pairs (a few blocks apart), where A* helps most.
+    mt19937 rng(7);
+    uniform_int_distribution<int> pick(0, city.size() - 1), step(-5, 5);
+    vector<pii> pairs(queries);
+    for (int i = 0; i < queries; i++) {
+        int s = pick(rng), t = pick(rng);
+        if (i % 2) {
+            int r = min(rows - 1, max(0, s / cols + step(rng))), c = min(cols - 1, max(0, s % cols + step(rng)));
+            t = r * cols + c;
+        }
+        pairs[i] = {s, t};
+    }
+
+    SearchWorkspace ws;
+    vector<int> path;
+    int mismatches = 0;
+    const char* kinds[2] = {"random pairs", "nearby pairs"};
+    printf("%-14s %-10s %14s %16s\n", "queries", "engine", "query (ms)", "settled/query");
+    for (int kind = 0; kind < 2; kind++) {
+        for (int heuristic = 0; heuristic < 2; heuristic++) {
+            long long settled = 0;
+            int n = 0;
+            t0 = chrono::steady_clock::now();
+            for (int i = kind; i < queries; i += 2, n++) {
+                alt.query(city, pairs[i].first, pairs[i].second, ws, nullptr, heuristic);
+                settled += ws.settled;
+            }
+            double ms = msSince(t0) / max(1, n);
+            printf("%-14s %-10s %14.3f %16.0f\n", kinds[kind], heuristic ? "ALT A*" : "Dijkstra", ms,
+                   (double)settled / max(1, n));
+        }
+    }
+
+    vector<int> dist, parent;
+    for (auto& p : pairs) {
+        int d = alt.query(city, p.first, p.second, ws, &path);
+        if (d != city.dijkstra(p.first, p.second, dist, parent) || !validRoute(city, p.first, p.second, d, path))
+            mismatches++;
+    }
+    printf("\n%d queries, %d mismatch(es) against CityGraph::dijkstra\n", queries, mismatches);
+    remove(altPath.c_str());
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Builds synthetic 24h profiles for a grid city, reports how far they compress, and times
+// "leave at" queries against the static Dijkstra on the same map.
+int runTrafficBenchmark(int rows, int cols, int queries) {
+    vector<int> eu, ev, ew;
+    gridRoads(rows, cols, 15, 42, eu, ev, ew);
+    CityGraph city;
+    city.assignRoads(rows * cols, eu, ev, ew);
+    long long slots = city.roadCount() * 2;
+    printf("Grid city: %d junctions, %lld one-way road slots\n", city.size(), slots);
+
+    TrafficProfiles traffic;
+    vector<uint8_t> kinds;
+    auto t0 = chrono::steady_clock::now();
+    synthesizeTraffic(city, traffic, 5, &kinds);
+    double buildMs = msSince(t0);
+    printf("Profiles built in %.1f ms: %d distinct, %.1f breakpoints each on average\n", buildMs,
+           traffic.profileCount(), (double)traffic.pointCount() / traffic.profileCount());
+    printf("Memory: %.2f MB compressed and shared vs %.2f MB for raw float samples per road\n",
+           traffic.bytes() / 1e6, slots * PROFILE_SLOTS * sizeof(float) / 1e6);
+
+    int worst = 0;
+    vector<int> samples;
+    for (long long e = 0; e < slots; e += max(1LL, slots / 1000)) {
+        rushHourSamples(city.roadTime(e), kinds[e], samples);
+        for (int i = 0; i < PROFILE_SLOTS; i++)
+            worst = max(worst, abs(traffic.travelTime(e, i * SLOT_SECONDS) - samples[i]));
+    }
+    printf("Largest deviation from the raw samples: %d s\n\n", worst);
+
+    // Cross-town trips of up to 15 blocks, short enough for the time of day to matter.
+    mt19937 rng(9);
+    uniform_int_distribution<int> pick(0, city.size() - 1), step(-15, 15);
+    vector<pii> pairs(queries);
+    for (auto& p : pairs) {
+        int s = pick(rng);
+        int r = min(rows - 1, max(0, s / cols + step(rng))), c = min(cols - 1, max(0, s % cols + step(rng)));
+        p = {s, r * cols + c};
+    }
+
+    SearchWorkspace ws;
+    vector<int> dist, parent, path;
+    t0 = chrono::steady_clock::now();
+    for (auto& p : pairs) city.dijkstra(p.first, p.second, dist, parent);
+    printf("%-22s %12s %16s\n", "query", "ms/query", "avg trip (min)");
+    printf("%-22s %12.3f %16s\n", "static Dijkstra", msSince(t0) / queries, "-");
+
+    // Every answer must replay to the same arrival along its own path and be no later
+    // than simply driving the static shortest path at that time of day.
+    int mismatches = 0;
+    for (const char* leave : {"03:00", "08:15", "17:45"}) {
+        int depart = parseClock(leave);
+        long long total = 0;
+        t0 = chrono::steady_clock::now();
+        for (auto& p : pairs) total += traffic.query(city, p.first, p.second, depart, ws) - depart;
+        double ms = msSince(t0) / queries;
+        printf("%-22s %12.3f %16.1f\n", ("leave at " + string(leave)).c_str(), ms, total / 60.0 / queries);
+
+        for (auto& p : pairs) {
+            int arrival = traffic.query(city, p.first, p.second, depart, ws, &path);
+            auto replay = [&](const vector<int>& route) {
+                int t = depart;
+                for (size_t i = 0; i + 1 < route.size(); i++) {
+                    int best = INT_MAX;
+                    for (int e = city.roadBegin(route[i]); e < city.roadEnd(route[i]); e++)
+                        if (city.roadTo(e) == route[i + 1]) best = min(best, t + traffic.travelTime(e, t));
+                    t = best;
+                }
+                return t;
+            };
+            city.dijkstra(p.first, p.second, dist, parent);
+            vector<int> staticPath;
+            for (int v = p.second; v != -1; v = parent[v]) staticPath.push_back(v);
+            reverse(staticPath.begin(), staticPath.end());
+            if (replay(path) != arrival || arrival > replay(staticPath)) mismatches++;
+        }
+    }
+
+    // With constant profiles the time-dependent search must reproduce the static one.
+    TrafficProfiles flat;
+    flat.reset(city);
+    for (auto& p : pairs)
+        if (flat.query(city, p.first, p.second, 0, ws) != city.dijkstra(p.first, p.second, dist, parent) * 60) mismatches++;
+    printf("\n%d checks, %d mismatch(es)\n", queries * 4, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Alternative routes for k = 1 .. 5 on a grid city: latency, how many routes were found and
+// how much longer the extra routes are. Every route is checked for validity and looplessness.
+int runAlternativeBenchmark(int rows, int cols, int queries) {
+    vector<int> eu, ev, ew;
+    gridRoads(rows, cols, 15, 42, eu, ev, ew);
+    CityGraph city;
+    city.assignRoads(rows * cols, eu, ev, ew);
+    printf("Grid city: %d junctions, %d queries\n\n", city.size(), queries);
+
+    mt19937 rng(13);
+    uniform_int_distribution<int> pick(0, city.size() - 1);
+    vector<pii> pairs(queries);
+    for (auto& p : pairs) p = {pick(rng), pick(rng)};
+
+    SearchWorkspace ws;
+    auto t0 = chrono::steady_clock::now();
+    for (auto& p : pairs) city.route(p.first, p.second, ws);
+    double dijkstraMs = msSince(t0) / queries;
+    printf("One Dijkstra: %.3f ms/query\n\n", dijkstraMs);
+
+    AlternativeRouteFinder finder;
+    vector<AlternativeRoute> routes;
+    vector<int> dist, parent;
+    int mismatches = 0;
+    printf("%-4s %12s %14s %14s %16s\n", "k", "ms/query", "x Dijkstra", "routes found", "avg stretch");
+    for (int k = 1; k <= 5; k++) {
+        long long found = 0;
+        double stretch = 0;
+        int extra = 0;
+        t0 = chrono::steady_clock::now();
+        for (auto& p : pairs) found += finder.find(city, p.first, p.second, k, routes);
+        double ms = msSince(t0) / queries;
+
+        for (auto& p : pairs) {
+            finder.find(city, p.first, p.second, k, routes);
+            int best = city.dijkstra(p.first, p.second, dist, parent);
+            if (routes.empty() || routes[0].minutes != best) { mismatches++; continue; }
+            for (size_t i = 0; i < routes.size(); i++) {
+                auto& r = routes[i];
+                vector<int> sorted = r.path;
+                sort(sorted.begin(), sorted.end());
+                if (!validRoute(city, p.first, p.second, r.minutes, r.path) || r.minutes > best * 1.25 + 1 ||
+                    adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+                    mismatches++;
+                if (i) { stretch += (double)r.minutes / best; extra++; }
+            }
+        }
+        printf("%-4d %12.3f %14.1f %14.2f %16.3f\n", k, ms, ms / dijkstraMs, (double)found / queries,
+               extra ? stretch / extra : 1.0);
+    }
+    printf("\n%d mismatch(es) (invalid, looping, too long, or first route not shortest)\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Starts a RouteServer on a Unix socket in this process and drives it with 'clients'
+// connections, each sending one request and waiting for the answer before the next.
+int runServeBenchmark(int rows, int cols, int requests, int clients, int threads, const string& engine) {
+    const string sockPath = "/tmp/city_bench.sock", altPath = "/tmp/city_bench_serve.alt";
+    vector<int> eu, ev, ew;
+    gridRoads(rows, cols, 15, 42, eu, ev, ew);
+    CityGraph city;
+    city.assignRoads(rows * cols, eu, ev, ew);
+
+    auto t0 = chrono::steady_clock::now();
+    ContractionHierarchy ch;
+    LandmarkTable alt;
+    if (engine == "ch") {
+        ch.build(city);
+    } else if (engine == "alt") {
+        if (!LandmarkTable::build(city, 16, altPath) || !alt.load(altPath)) { cerr << "Could not write " << altPath << "\n"; return 1; }
+    } else if (engine != "dijkstra") {
+        cerr << "Unknown engine " << engine << " (dijkstra, ch or alt)\n";
+        return 1;
+    }
+    printf("Grid city: %d junctions, engine %s (preprocessing %.1f ms, paid once at startup)\n",
+           city.size(), engine.c_str(), msSince(t0));
+    printf("%d client(s), %d worker thread(s), %d requests\n\n", clients, threads, requests);
+
+    mt19937 rng(11);
+    uniform_int_distribution<int> pick(0, city.size() - 1);
+    vector<pii> pairs(requests);
+    for (auto& p : pairs) p = {pick(rng), pick(rng)};
+
+    RouteServer server(city, engine == "ch" ? &ch : nullptr, engine == "alt" ? &alt : nullptr, threads);
+    thread acceptor([&] { server.serveSocket(sockPath); });
+
+    vector<double> latency(requests);
+    vector<int> answer(requests, -1);
+    atomic<int> nextRequest{0}, failures{0};
+    t0 = chrono::steady_clock::now();
+    vector<thread> load;
+    for (int c = 0; c < clients; c++) {
+        load.emplace_back([&] {
+            int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            strcpy(addr.sun_path, sockPath.c_str());
+            // The acceptor thread may not be listening yet.
+            for (int tries = 0; ::connect(fd, (sockaddr*)&addr, sizeof addr) < 0; tries++) {
+                if (tries == 1000) { failures++; ::close(fd); return; }
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+            FdLineReader reader(fd);
+            string request, response, minutes;
+            for (int i; (i = nextRequest++) < requests;) {
+                request = "{\"id\":" + to_string(i) + ",\"from\":\"" + city.placeName(pairs[i].first) +
+                          "\",\"to\":\"" + city.placeName(pairs[i].second) + "\"}\n";
+                auto sent = chrono::steady_clock::now();
+                if (::send(fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size() ||
+                    !reader.next(response)) {
+                    failures++;
+                    break;
+                }
+                latency[i] = msSince(sent);
+                if (jsonField(response, "minutes", minutes)) answer[i] = stoi(minutes);
+            }
+            ::close(fd);
+        });
+    }
+    for (auto& t : load) t.join();
+    double totalMs = msSince(t0);
+    server.stop();
+    acceptor.join();
+    remove(altPath.c_str());
+
+    vector<double> sorted = latency;
+    sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double q) { return sorted[min(requests - 1, (int)(q * requests))]; };
+    printf("%-12s %10s %10s %10s %10s\n", "", "p50 (ms)", "p99 (ms)", "max (ms)", "req/s");
+    printf("%-12s %10.3f %10.3f %10.3f %10.0f\n", engine.c_str(), percentile(0.50), percentile(0.99),
+           sorted.back(), requests / (totalMs / 1000));
+
+    // Spot-check answers against a plain Dijkstra.
+    int checked = min(requests, 100), mismatches = failures;
+    vector<int> dist, parent;
+    for (int i = 0; i < checked; i++)
+        if (answer[i] != city.dijkstra(pairs[i].first, pairs[i].second, dist, parent)) mismatches++;
+    printf("\n%d answers checked, %d mismatch(es) / failed request(s)\n", checked, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        int rows = argc > 2 ? atoi(argv[2]) : 1000;
+        int cols = argc > 3 ? atoi(argv[3]) : 1000;
+        int queries = argc > 4 ? atoi(argv[4]) : 50;
+        return runBenchmark(rows, cols, queries);
+    }
+    if (argc > 1 && string(argv[1]) == "pq-bench")
+        return runQueueBenchmark(argc > 2 ? atoi(argv[2]) : 10);
+    if (argc > 1 && string(argv[1]) == "ch-bench") {
+        int rows = argc > 2 ? atoi(argv[2]) : 300;
+        int cols = argc > 3 ? atoi(argv[3]) : 300;
+        int queries = argc > 4 ? atoi(argv[4]) : 1000;
+        return runCHBenchmark(rows, cols, queries);
+    }
+    if (argc > 1 && string(argv[1]) == "alt-bench") {
+        int rows = argc > 2 ? atoi(argv[2]) : 500;
+        int cols = argc > 3 ? atoi(argv[3]) : 500;
+        int queries = argc > 4 ? atoi(argv[4]) : 200;
+        int landmarks = argc > 5 ? atoi(argv[5]) : 16;
+        return runAltBenchmark(rows, cols, queries, landmarks);
+    }
+    if (argc > 1 && string(argv[1]) == "td-bench") {
+        int rows = argc > 2 ? atoi(argv[2]) : 300;
+        int cols = argc > 3 ? atoi(argv[3]) : 300;
+        int queries = argc > 4 ? atoi(argv[4]) : 100;
+        return runTrafficBenchmark(rows, cols, queries);
+    }
+    if (argc > 1 && string(argv[1]) == "td-profiles") {
+        if (argc < 5) {
+            cerr << "Usage: " << argv[0] << " td-profiles <nodes.csv> <edges.csv> <out.csv>\n";
+            return 1;
+        }
+        CityGraph city;
+        if (!city.loadFromCSV(argv[2], argv[3])) return 1;
+        ofstream out(argv[4]);
+        if (!out) { cerr << "Could not write " << argv[4] << "\n"; return 1; }
+        out << "source,target,profile\n";
+        mt19937 rng(5);
+        vector<int> samples;
+        for (int u = 0; u < city.size(); u++)
+            for (int e = city.roadBegin(u); e < city.roadEnd(u); e++) {
+                rushHourSamples(city.roadTime(e), rng() % 5, samples);
+                out << city.junctionId(u) << ',' << city.junctionId(city.roadTo(e)) << ',';
+                for (int i = 0; i < PROFILE_SLOTS; i++) out << (i ? " " : "") << samples[i] / 60.0;
+                out << '\n';
+            }
+        cout << "Wrote profiles for " << city.roadCount() * 2 << " one-way roads to " << argv[4] << ".\n";
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "routes-bench") {
+        int rows = argc > 2 ? atoi(argv[2]) : 200;
+        int cols = argc > 3 ? atoi(argv[3]) : 200;
+        int queries = argc > 4 ? atoi(argv[4]) : 100;
+        return runAlternativeBenchmark(rows, cols, queries);
+    }
+    if (argc > 1 && string(argv[1]) == "serve-bench") {
+        int rows = argc > 2 ? atoi(argv[2]) : 200;
+        int cols = argc > 3 ? atoi(argv[3]) : 200;
+        int requests = argc > 4 ? atoi(argv[4]) : 2000;
+        int clients = argc > 5 ? atoi(argv[5]) : 8;
+        int threads = argc > 6 ? atoi(argv[6]) : (int)max(1u, thread::hardware_concurrency());
+        string engine = argc > 7 ? argv[7] : "alt";
+        return runServeBenchmark(rows, cols, requests, clients, threads, engine);
+    }
+    if (argc > 1 && string(argv[1]) == "serve") {
+        string sockPath, chPath, altPath;
+        int threads = max(1u, thread::hardware_concurrency());
+        vector<string> files;
+        for (int i = 2; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--socket" && i + 1 < argc) sockPath = argv[++i];
+            else if (arg == "--ch" && i + 1 < argc) chPath = argv[++i];
+            else if (arg == "--alt" && i + 1 < argc) altPath = argv[++i];
+            else if (arg == "--threads" && i + 1 < argc) threads = atoi(argv[++i]);
+            else files.push_back(arg);
+        }
+        CityGraph city;
+        if (!city.loadFromCSV(files.size() >= 2 ? files[0] : "nodes.csv", files.size() >= 2 ? files[1] : "edges.csv"))
+            return 1;
+        ContractionHierarchy ch;
+        if (!chPath.empty() && (!ch.load(chPath) || ch.size() != city.size())) {
+            cerr << "Could not load a hierarchy for this map from " << chPath << "\n";
+            return 1;
+        }
+        LandmarkTable alt;
+        if (!altPath.empty() && (!alt.load(altPath) || alt.size() != city.size())) {
+            cerr << "Could not load landmark tables for this map from " << altPath << "\n";
+            return 1;
+        }
+        RouteServer server(city, chPath.empty() ? nullptr : &ch, altPath.empty() ? nullptr : &alt, threads);
+        if (sockPath.empty()) {
+            server.serveStdio();
+        } else {
+            cerr << "Serving " << city.size() << " junctions on " << sockPath << "\n";
+            if (!server.serveSocket(sockPath)) { cerr << "Could not listen on " << sockPath << "\n"; return 1; }
+        }
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "alt-build") {
+        if (argc < 5) {
+            cerr << "Usage: " << argv[0] << " alt-build <nodes.csv> <edges.csv> <out.alt> [landmarks]\n";
+            return 1;
+        }
+        CityGraph city;
+        if (!city.loadFromCSV(argv[2], argv[3])) return 1;
+        int landmarks = argc > 5 ? atoi(argv[5]) : 16;
+        if (!LandmarkTable::build(city, landmarks, argv[4])) { cerr << "Could not write " << argv[4] << "\n"; return 1; }
+        cout << "Wrote landmark distances for " << city.size() << " junctions to " << argv[4] << ".\n";
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "ch-build") {
+        if (argc < 5) {
+            cerr << "Usage: " << argv[0] << " ch-build <nodes.csv> <edges.csv> <out.ch>\n";
+            return 1;
+        }
+        CityGraph city;
+        if (!city.loadFromCSV(argv[2], argv[3])) return 1;
+        ContractionHierarchy ch;
+        ch.build(city);
+        if (!ch.save(argv[4])) { cerr << "Could not write " << argv[4] << "\n"; return 1; }
+        cout << "Contracted " << ch.size() << " junctions into " << ch.arcCount() << " upward arcs.\n";
+        return 0;
+    }
+
+    // "./code ch <city.ch> [nodes.csv edges.csv]" and "./code alt <city.alt> [...]" answer
+    // the query from prebuilt preprocessing data; "./code td <profiles.csv> [...]" uses
+    // time-dependent travel times; "./code routes <k> [...]" lists alternatives.
+    bool useCH = argc > 2 && string(argv[1]) == "ch";
+    bool useALT = argc > 2 && string(argv[1]) == "alt";
+    bool useTD = argc > 2 && string(argv[1]) == "td";
+    bool useRoutes = argc > 2 && string(argv[1]) == "routes";
+    int first = useCH || useALT || useTD || useRoutes ? 3 : 1;
+    string nodesPath = argc > first + 1 ? argv[first] : "nodes.csv";
+    string edgesPath = argc > first + 1 ? argv[first + 1] : "edges.csv";
+
+    CityGraph city;
+    if (!city.loadFromCSV(nodesPath, edgesPath)) return 1;
+
+    ContractionHierarchy ch;
+    if (useCH && (!ch.load(argv[2]) || ch.size() != city.size())) {
+        cerr << "Could not load a hierarchy for this map from " << argv[2] << "\n";
+        return 1;
+    }
+    LandmarkTable alt;
+    if (useALT && (!alt.load(argv[2]) || alt.size() != city.size())) {
+        cerr << "Could not load landmark tables for this map from " << argv[2] << "\n";
+        return 1;
+    }
+    TrafficProfiles traffic;
+    if (useTD && !traffic.loadFromCSV(city, argv[2])) return 1;
 
     string sourceName, destName;
     cout << "Enter source place name: ";
@@ -114,19 +2263,60 @@ int main() {
     getline(cin, destName);
 
     // Find node IDs
-    int src = -1, dest = -1;
-    for(auto &p: idToName) {
-        if(p.second == sourceName) src = p.first;
-        if(p.second == destName) dest = p.first;
-    }
+    int src = city.findPlace(sourceName);
+    int dest = city.findPlace(destName);
 
     if(src == -1 || dest == -1) {
         cout << "Invalid source or destination name entered!\n";
         return 0;
     }
 
-    city.shortestPath(src, dest, idToName);
+    if (useTD) {
+        string leave;
+        cout << "Enter departure time (HH:MM): ";
+        getline(cin, leave);
+        int depart = parseClock(leave);
+        if (depart < 0) {
+            cout << "Invalid departure time entered!\n";
+            return 0;
+        }
+        SearchWorkspace ws;
+        vector<int> path;
+        int arrival = traffic.query(city, src, dest, depart, ws, &path);
+        if (arrival == INT_MAX) {
+            cout << "No path found from " << sourceName << " to " << destName << endl;
+            return 0;
+        }
+        printf("\nLeaving %s at %s, arrive at %s after %.1f minutes\n", sourceName.c_str(),
+               formatClock(depart).c_str(), formatClock(arrival).c_str(), (arrival - depart) / 60.0);
+        cout << "Path: ";
+        for (size_t i = 0; i < path.size(); i++)
+            cout << city.placeName(path[i]) << (i + 1 == path.size() ? "\n" : " -> ");
+    } else if (useRoutes) {
+        AlternativeRouteFinder finder;
+        vector<AlternativeRoute> routes;
+        if (finder.find(city, src, dest, atoi(argv[2]), routes) == 0) {
+            city.printRoute(src, dest, INT_MAX, {});
+            return 0;
+        }
+        for (size_t i = 0; i < routes.size(); i++) {
+            cout << "\nRoute " << i + 1 << ": " << routes[i].minutes << " minutes\nPath: ";
+            for (size_t j = 0; j < routes[i].path.size(); j++)
+                cout << city.placeName(routes[i].path[j]) << (j + 1 == routes[i].path.size() ? "\n" : " -> ");
+        }
+    } else if (useCH) {
+        CHWorkspace ws;
+        vector<int> path;
+        int minutes = ch.query(src, dest, ws, &path);
+        city.printRoute(src, dest, minutes, path);
+    } else if (useALT) {
+        SearchWorkspace ws;
+        vector<int> path;
+        int minutes = alt.query(city, src, dest, ws, &path);
+        city.printRoute(src, dest, minutes, path);
+    } else {
+        city.shortestPath(src, dest);
+    }
 
     return 0;
 }
-
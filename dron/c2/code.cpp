@@ -4,6 +4,15 @@
   of flight records. The core sorting step now uses an explicit O(N log N)
   Merge Sort implementation to prepare the data for the Greedy scheduling logic
   (using a Min-Heap/Priority Queue).
+
+  Usage:
+    ./code                           interactive input, as before
+    ./code batch <flights.csv> [out.csv]   stream a whole season from CSV (see Batch Mode)
+    ./code bench [flights]           batch mode vs the interactive data path on synthetic flights
+    ./code online <flights.csv> <events.csv> [out.csv]   apply delay/cancel/insert events live
+    ./code online-bench [flights events]   replay a recorded event log, per-event latency
+    ./code schedule <season.csv> [threads] [out.csv]   multi-day, multi-terminal, per-class gates
+    ./code schedule-bench [flights days terminals]     flights/sec as worker threads increase
 */
 
 #include <iostream>
@@ -15,6 +24,18 @@
 #include <queue>
 #include <unordered_map>
 #include <limits> // Needed for numeric_limits
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <cstdint>
+#include <map>
+#include <climits>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <tuple>
 
 using namespace std;
 
@@ -121,9 +142,1306 @@ void mergeSort(vector<Flight>& arr, int left, int right) {
   merge(arr, left, mid, right);
 }
 
+// --- Greedy Gate Assignment ---
+
+/**
+* @brief Assigns gates to flights already sorted by arrival; returns the number of gates used.
+*/
+int assignGates(const vector<Flight>& flights, unordered_map<string,int>& flightGate) {
+  // Min-Heap (Priority Queue): Stores the availability time (<Departure_Time, Gate_Number>)
+  // The top element is the earliest free gate.
+  priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> gateHeap;
+
+  int gateCount = 0; // Tracks the minimum number of gates used
+
+  for (const auto &f : flights) {
+   
+    if (!gateHeap.empty() && gateHeap.top().first <= f.arrival) {
+      // REUSE GATE: The earliest available gate is free before the current flight arrives.
+      int gateNum = gateHeap.top().second;
+      gateHeap.pop();
+      gateHeap.push({f.departure, gateNum}); // Update availability time
+      flightGate[f.id] = gateNum;
+     
+    } else {
+      // NEW GATE: No gate is available, so a new one is required.
+      gateCount++;
+      gateHeap.push({f.departure, gateCount}); // Add new gate with its release time
+      flightGate[f.id] = gateCount;
+    }
+  }
+  return gateCount;
+}
+
+// --- Batch Mode ---
+// A season's schedule (hundreds of thousands of flights) is streamed from flights.csv
+// (flight_id,arrival_time,departure_time) into a struct-of-arrays table: times are plain
+// ints and flight IDs are interned, so a flight costs 12 bytes plus one copy of each
+// distinct ID. Arrival minutes lie in a small range, so a stable counting sort orders the
+// flights in O(N) using one reusable index buffer, and the greedy runs on that order.
+
+/**
+* @brief Reads a file through one fixed-size buffer, one line at a time.
+*/
+class CsvLineReader {
+  FILE* file;
+  vector<char> buf;
+  size_t start = 0, end = 0;
+  bool eof = false;
+
+public:
+  explicit CsvLineReader(const string& path, size_t bufferSize = 1 << 20)
+    : file(fopen(path.c_str(), "rb")), buf(bufferSize) {}
+  ~CsvLineReader() { if (file) fclose(file); }
+  bool ok() const { return file != nullptr; }
+
+  // Points 'line' at the next line (without '\n' or '\r'); valid until the next call.
+  bool next(const char*& line, size_t& len) {
+    while (true) {
+      const char* nl = (const char*)memchr(buf.data() + start, '\n', end - start);
+      if (nl || (eof && start < end)) {
+        line = buf.data() + start;
+        len = (nl ? nl - line : end - start);
+        start += len + (nl ? 1 : 0);
+        if (len && line[len - 1] == '\r') len--;
+        return true;
+      }
+      if (eof) return false;
+      // Move the partial line to the front and refill; grow if one line fills the buffer.
+      memmove(buf.data(), buf.data() + start, end - start);
+      end -= start;
+      start = 0;
+      if (end == buf.size()) buf.resize(buf.size() * 2);
+      size_t got = fread(buf.data() + end, 1, buf.size() - end, file);
+      end += got;
+      if (got == 0) eof = true;
+    }
+  }
+};
+
+/**
+* @brief Same rules as timeToMinutes ("HH:MM", two digits each), without allocating.
+*/
+int parseMinutes(const char* s, size_t len) {
+  if (len != 5 || s[2] != ':') return -1;
+  for (int i : {0, 1, 3, 4})
+    if (s[i] < '0' || s[i] > '9') return -1;
+  return ((s[0] - '0') * 10 + (s[1] - '0')) * 60 + (s[3] - '0') * 10 + (s[4] - '0');
+}
+
+/**
+* @brief Flights stored column by column; row i is one flight.
+*/
+struct FlightTable {
+  vector<int> arrival;      // Minutes from midnight
+  vector<int> departure;    // Minutes from midnight
+  vector<uint32_t> idRef;   // Index into ids
+  vector<string> ids;       // Each distinct flight ID once
+  unordered_map<string, uint32_t> idIndex;
+  string key;               // Reused lookup buffer
+
+  size_t size() const { return arrival.size(); }
+
+  uint32_t intern(const char* s, size_t len) {
+    key.assign(s, len);
+    auto it = idIndex.find(key);
+    if (it != idIndex.end()) return it->second;
+    ids.push_back(key);
+    idIndex.emplace(key, ids.size() - 1);
+    return ids.size() - 1;
+  }
+
+  void add(uint32_t id, int arr, int dep) {
+    idRef.push_back(id);
+    arrival.push_back(arr);
+    departure.push_back(dep);
+  }
+
+  /**
+  * @brief Streams flights.csv; rows with bad times or departure <= arrival are skipped.
+  */
+  bool loadCSV(const string& path, long long& skipped) {
+    CsvLineReader in(path);
+    if (!in.ok()) return false;
+    const char* line;
+    size_t len;
+    skipped = 0;
+    in.next(line, len); // Skip header
+    while (in.next(line, len)) {
+      if (len == 0) continue;
+      const char* c1 = (const char*)memchr(line, ',', len);
+      const char* c2 = c1 ? (const char*)memchr(c1 + 1, ',', line + len - c1 - 1) : nullptr;
+      int arr = c2 ? parseMinutes(c1 + 1, c2 - c1 - 1) : -1;
+      int dep = c2 ? parseMinutes(c2 + 1, line + len - c2 - 1) : -1;
+      if (arr == -1 || dep == -1 || arr >= dep) { skipped++; continue; }
+      add(intern(line, c1 - line), arr, dep);
+    }
+    return true;
+  }
+};
+
+/**
+* @brief Stable counting sort of row indices by arrival minute (same order as mergeSort).
+*/
+void sortByArrival(const FlightTable& t, vector<uint32_t>& order, vector<uint32_t>& counts) {
+  int maxMinute = 0;
+  for (int a : t.arrival) maxMinute = max(maxMinute, a);
+  counts.assign(maxMinute + 2, 0);
+  for (int a : t.arrival) counts[a + 1]++;
+  for (int m = 0; m <= maxMinute; m++) counts[m + 1] += counts[m];
+  order.resize(t.size());
+  for (uint32_t i = 0; i < t.size(); i++) order[counts[t.arrival[i]]++] = i;
+}
+
+/**
+* @brief The assignGates greedy over a FlightTable in 'order'; gate[i] is row i's gate.
+*/
+int assignGates(const FlightTable& t, const vector<uint32_t>& order, vector<int>& gate) {
+  vector<pair<int,int>> storage;
+  storage.reserve(1024);
+  priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> gateHeap(greater<pair<int,int>>(), move(storage));
+  int gateCount = 0;
+  gate.resize(t.size());
+  for (uint32_t i : order) {
+    if (!gateHeap.empty() && gateHeap.top().first <= t.arrival[i]) {
+      int gateNum = gateHeap.top().second;
+      gateHeap.pop();
+      gateHeap.push({t.departure[i], gateNum});
+      gate[i] = gateNum;
+    } else {
+      gateCount++;
+      gateHeap.push({t.departure[i], gateCount});
+      gate[i] = gateCount;
+    }
+  }
+  return gateCount;
+}
+
+/**
+* @brief ./code batch <flights.csv> [out.csv]: prints the gate count and optionally writes
+* flight_id,arrival_time,departure_time,gate in arrival order.
+*/
+int runBatch(const string& inPath, const string& outPath) {
+  FlightTable table;
+  long long skipped;
+  if (!table.loadCSV(inPath, skipped)) {
+    cerr << "Could not open " << inPath << "\n";
+    return 1;
+  }
+  if (skipped) cerr << "Warning: skipped " << skipped << " flight(s) with invalid times.\n";
+
+  vector<uint32_t> order, counts;
+  vector<int> gate;
+  sortByArrival(table, order, counts);
+  int gateCount = assignGates(table, order, gate);
+  cout << "Flights: " << table.size() << " (" << table.ids.size() << " distinct IDs)\n";
+  cout << "Total Gates Required: " << gateCount << "\n";
+
+  if (!outPath.empty()) {
+    FILE* out = fopen(outPath.c_str(), "w");
+    if (!out) { cerr << "Could not write " << outPath << "\n"; return 1; }
+    fputs("flight_id,arrival_time,departure_time,gate\n", out);
+    for (uint32_t i : order)
+      fprintf(out, "%s,%02d:%02d,%02d:%02d,%d\n", table.ids[table.idRef[i]].c_str(), table.arrival[i] / 60,
+              table.arrival[i] % 60, table.departure[i] / 60, table.departure[i] % 60, gate[i]);
+    fclose(out);
+  }
+  return 0;
+}
+
+double msSince(chrono::steady_clock::time_point t0) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+/**
+* @brief Writes a synthetic flights.csv and runs both the original data path (getline,
+* vector<Flight>, mergeSort, assignGates) and batch mode on it.
+*/
+int runBenchmark(int numFlights) {
+  const string path = "/tmp/flights_bench.csv";
+  {
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out) { cerr << "Could not write " << path << "\n"; return 1; }
+    mt19937 rng(42);
+    uniform_int_distribution<int> arrival(0, 22 * 60), stay(20, 180), number(100, 9999);
+    const char* airlines[] = {"AI", "6E", "SG", "UK", "AK", "QP"};
+    fputs("flight_id,arrival_time,departure_time\n", out);
+    for (int i = 0; i < numFlights; i++) {
+      int arr = arrival(rng), dep = min(arr + stay(rng), 23 * 60 + 59);
+      fprintf(out, "%s%d,%02d:%02d,%02d:%02d\n", airlines[rng() % 6], number(rng), arr / 60, arr % 60, dep / 60, dep % 60);
+    }
+    fclose(out);
+  }
+  cout << "Synthetic season: " << numFlights << " flights\n\n";
+
+  // Original path: parse into vector<Flight> with string fields, mergeSort, greedy.
+  auto t0 = chrono::steady_clock::now();
+  vector<Flight> flights;
+  {
+    ifstream in(path);
+    string line;
+    getline(in, line);
+    while (getline(in, line)) {
+      stringstream ss(line);
+      Flight f;
+      getline(ss, f.id, ',');
+      getline(ss, f.arrivalStr, ',');
+      getline(ss, f.departureStr, ',');
+      f.arrival = timeToMinutes(f.arrivalStr);
+      f.departure = timeToMinutes(f.departureStr);
+      if (f.arrival == -1 || f.departure == -1 || f.arrival >= f.departure) continue;
+      flights.push_back(f);
+    }
+  }
+  double oldLoad = msSince(t0);
+  t0 = chrono::steady_clock::now();
+  mergeSort(flights, 0, flights.size() - 1);
+  double oldSort = msSince(t0);
+  t0 = chrono::steady_clock::now();
+  unordered_map<string,int> flightGate;
+  int oldGates = assignGates(flights, flightGate);
+  double oldAssign = msSince(t0);
+
+  // Batch mode.
+  t0 = chrono::steady_clock::now();
+  FlightTable table;
+  long long skipped;
+  table.loadCSV(path, skipped);
+  double newLoad = msSince(t0);
+  t0 = chrono::steady_clock::now();
+  vector<uint32_t> order, counts;
+  sortByArrival(table, order, counts);
+  double newSort = msSince(t0);
+  t0 = chrono::steady_clock::now();
+  vector<int> gate;
+  int newGates = assignGates(table, order, gate);
+  double newAssign = msSince(t0);
+
+  printf("%-12s %12s %12s %12s %12s\n", "", "load (ms)", "sort (ms)", "assign (ms)", "total (ms)");
+  printf("%-12s %12.1f %12.1f %12.1f %12.1f\n", "original", oldLoad, oldSort, oldAssign, oldLoad + oldSort + oldAssign);
+  printf("%-12s %12.1f %12.1f %12.1f %12.1f\n", "batch", newLoad, newSort, newAssign, newLoad + newSort + newAssign);
+  printf("\nFlight storage: %.1f MB as vector<Flight>, %.1f MB as columns + %zu interned IDs\n",
+         flights.capacity() * sizeof(Flight) / 1e6, table.size() * 12 / 1e6, table.ids.size());
+
+  // Both sorts are stable, so the i-th flight in each order is the same flight.
+  int mismatches = oldGates != newGates || flights.size() != table.size();
+  for (size_t i = 0; !mismatches && i < order.size(); i++)
+    if (flights[i].arrival != table.arrival[order[i]] || flights[i].departure != table.departure[order[i]] ||
+        flights[i].id != table.ids[table.idRef[order[i]]])
+      mismatches++;
+  printf("Gates required: %d (original) vs %d (batch), %d mismatch(es) in sorted order\n", oldGates, newGates, mismatches);
+  remove(path.c_str());
+  return mismatches == 0 ? 0 : 1;
+}
+
+// --- Online Reassignment ---
+// After the initial greedy assignment, each gate keeps its flights in a balanced search tree
+// (std::map keyed by arrival). A gate's flights never overlap, so a new interval [a, d)
+// fits a gate iff its predecessor leaves by a and its successor arrives at or after d:
+// two O(log n) lookups. Delay, cancel and insert events then update only what they touch:
+//   1. keep a delayed flight at its own gate if it still fits there;
+//   2. otherwise use the gate whose previous departure is latest before the arrival (best fit);
+//   3. otherwise move a single blocking flight to another gate to make room;
+//   4. otherwise open a new gate.
+// Steps 2 and 3 never scan the gates: the idle gaps of all gates, and the stretch each flight
+// alone occupies between its neighbours, are kept in interval indexes, so an event costs
+// O(log n) plus one lookup per gate that a single flight blocks.
+// Cancellations simply free their interval, so the gate count can drift above the optimum
+// that a full recomputation would find; the replay benchmark reports that drift.
+
+/**
+* @brief Intervals [start, end] tagged with a gate (at most one per start and gate) in a treap
+* ordered by start, augmented with the largest end in each subtree, so the intervals that
+* cover a query range are found without looking at the others.
+*/
+class IntervalIndex {
+  struct Node {
+    int start, end, gate, payload;
+    uint32_t priority;
+    int left, right, maxEnd;
+  };
+  vector<Node> nodes;
+  vector<int> spare; // Erased node slots
+  int root = -1;
+  uint32_t seed = 2463534242u;
+
+  // Order by start; at equal starts the lower gate sorts last, so it wins "latest start" ties.
+  static bool before(int startA, int gateA, int startB, int gateB) {
+    return startA != startB ? startA < startB : gateA > gateB;
+  }
+
+  void pull(int t) {
+    Node& n = nodes[t];
+    n.maxEnd = n.end;
+    if (n.left >= 0) n.maxEnd = max(n.maxEnd, nodes[n.left].maxEnd);
+    if (n.right >= 0) n.maxEnd = max(n.maxEnd, nodes[n.right].maxEnd);
+  }
+
+  // Splits t into keys before (start, gate) and the rest.
+  void split(int t, int start, int gate, int& l, int& r) {
+    if (t < 0) { l = r = -1; return; }
+    if (before(nodes[t].start, nodes[t].gate, start, gate)) {
+      split(nodes[t].right, start, gate, nodes[t].right, r);
+      l = t;
+    } else {
+      split(nodes[t].left, start, gate, l, nodes[t].left);
+      r = t;
+    }
+    pull(t);
+  }
+
+  int merge(int l, int r) {
+    if (l < 0 || r < 0) return l < 0 ? r : l;
+    if (nodes[l].priority > nodes[r].priority) {
+      nodes[l].right = merge(nodes[l].right, r);
+      pull(l);
+      return l;
+    }
+    nodes[r].left = merge(l, nodes[r].left);
+    pull(r);
+    return r;
+  }
+
+  int latest(int t, int a, int d, int skip) const {
+    if (t < 0 || nodes[t].maxEnd < d) return -1;
+    const Node& n = nodes[t];
+    if (n.start > a) return latest(n.left, a, d, skip);
+    int found = latest(n.right, a, d, skip);
+    if (found >= 0) return found;
+    if (n.end >= d && n.gate != skip) return t;
+    return latest(n.left, a, d, skip);
+  }
+
+  template <class Visit>
+  void covering(int t, int a, int d, Visit& visit) const {
+    if (t < 0 || nodes[t].maxEnd < d) return;
+    const Node& n = nodes[t];
+    covering(n.left, a, d, visit);
+    if (n.start > a) return;
+    if (n.end >= d) visit(n.gate, n.payload);
+    covering(n.right, a, d, visit);
+  }
+
+public:
+  void insert(int start, int end, int gate, int payload = -1) {
+    int t;
+    if (!spare.empty()) { t = spare.back(); spare.pop_back(); }
+    else { t = nodes.size(); nodes.emplace_back(); }
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; // xorshift32
+    nodes[t] = {start, end, gate, payload, seed, -1, -1, end};
+    int l, r;
+    split(root, start, gate, l, r);
+    root = merge(merge(l, t), r);
+  }
+
+  void erase(int start, int gate) {
+    int l, mid, r;
+    split(root, start, gate, l, mid);
+    split(mid, start, gate - 1, mid, r); // Keys up to (start, gate) inclusive
+    if (mid >= 0) spare.push_back(mid);
+    root = merge(l, r);
+  }
+
+  /**
+  * @brief Gate of the latest-starting interval with start <= a and end >= d, ignoring
+  * gate 'skip'; -1 if there is none. Expected O(log n) when each gate's intervals are disjoint.
+  */
+  int latestCovering(int a, int d, int skip) const {
+    int t = latest(root, a, d, skip);
+    return t < 0 ? -1 : nodes[t].gate;
+  }
+
+  /**
+  * @brief Calls visit(gate, payload) for every interval with start <= a and end >= d.
+  */
+  template <class Visit>
+  void forEachCovering(int a, int d, Visit visit) const { covering(root, a, d, visit); }
+};
+
+/**
+* @brief Live gate assignment that absorbs schedule changes one event at a time.
+*/
+class OnlineGateAssigner {
+  struct Slot {
+    int arrival, departure;
+    int gate; // -1 once cancelled
+  };
+  vector<Slot> flights;               // Indexed by row
+  vector<string> ids;                 // Row -> flight ID
+  unordered_map<string, int> rowOf;   // Flight ID -> row
+  vector<map<int, int>> gates;        // Per gate: arrival -> row
+  // Every idle stretch of every gate, from the previous departure (INT_MIN if none) to the
+  // next arrival (INT_MAX if none): [a, d) fits a gate iff one of its gaps covers it.
+  IntervalIndex gaps;
+  // Per seated flight (payload: row), the stretch between its neighbours' departure and
+  // arrival: if no gate fits [a, d), these are the flights that alone block a gate.
+  IntervalIndex spans;
+
+  // Departure of the flight before 'it' on gate g, or INT_MIN.
+  int departureBefore(int g, map<int, int>::const_iterator it) const {
+    return it == gates[g].begin() ? INT_MIN : flights[prev(it)->second].departure;
+  }
+
+  // Arrival of the flight at or after 'it' on gate g, or INT_MAX.
+  int arrivalFrom(int g, map<int, int>::const_iterator it) const {
+    return it == gates[g].end() ? INT_MAX : it->first;
+  }
+
+  void addGate() {
+    gaps.insert(INT_MIN, INT_MAX, gates.size());
+    gates.emplace_back();
+  }
+
+  void put(int row, int g) {
+    Slot& f = flights[row];
+    f.gate = g;
+    auto it = gates[g].emplace(f.arrival, row).first;
+    int before = departureBefore(g, it), after = arrivalFrom(g, next(it));
+    gaps.erase(before, g);
+    gaps.insert(before, f.arrival, g);
+    gaps.insert(f.departure, after, g);
+    if (it != gates[g].begin()) { // The previous flight's span now ends at this arrival
+      int p = prev(it)->second;
+      spans.erase(departureBefore(g, prev(it)), g);
+      spans.insert(departureBefore(g, prev(it)), f.arrival, g, p);
+    }
+    if (next(it) != gates[g].end()) { // The next flight's span now starts at this departure
+      int n = next(it)->second;
+      spans.erase(before, g);
+      spans.insert(f.departure, arrivalFrom(g, next(next(it))), g, n);
+    }
+    spans.insert(before, after, g, row);
+  }
+
+  void take(int row) {
+    Slot& f = flights[row];
+    int g = f.gate;
+    auto it = gates[g].find(f.arrival);
+    int before = departureBefore(g, it), after = arrivalFrom(g, next(it));
+    spans.erase(before, g);
+    if (next(it) != gates[g].end()) {
+      int n = next(it)->second;
+      spans.erase(f.departure, g);
+      spans.insert(before, arrivalFrom(g, next(next(it))), g, n);
+    }
+    if (it != gates[g].begin()) {
+      int p = prev(it)->second;
+      spans.erase(departureBefore(g, prev(it)), g);
+      spans.insert(departureBefore(g, prev(it)), after, g, p);
+    }
+    gaps.erase(before, g);
+    gaps.erase(f.departure, g);
+    gaps.insert(before, after, g);
+    gates[g].erase(it);
+    f.gate = -1;
+  }
+
+  // True if [a, d) overlaps nothing on gate g.
+  bool fits(int g, int a, int d) const {
+    auto next = gates[g].lower_bound(a);
+    return arrivalFrom(g, next) >= d && departureBefore(g, next) <= a;
+  }
+
+  // Best-fit free gate for [a, d) other than 'skip', or -1: the gate whose previous departure
+  // is latest (an empty gate counts as never used), lowest gate on ties.
+  int bestGate(int a, int d, int skip) const { return gaps.latestCovering(a, d, skip); }
+
+  // Seats an unassigned row, preferring 'preferred'; returns how many other flights moved.
+  int place(int row, int preferred) {
+    int a = flights[row].arrival, d = flights[row].departure;
+    if (preferred >= 0 && fits(preferred, a, d)) { put(row, preferred); return 0; }
+    int g = bestGate(a, d, -1);
+    if (g >= 0) { put(row, g); return 0; }
+
+    // One-move repair: the lowest gate where exactly one flight is in the way and that flight
+    // fits somewhere else.
+    vector<pair<int, int>> blockers; // (gate, row)
+    spans.forEachCovering(a, d, [&](int gate, int blocker) { blockers.push_back({gate, blocker}); });
+    sort(blockers.begin(), blockers.end());
+    for (auto [gate, blocker] : blockers) {
+      int other = bestGate(flights[blocker].arrival, flights[blocker].departure, gate);
+      if (other < 0) continue;
+      take(blocker);
+      put(blocker, other);
+      put(row, gate);
+      return 1;
+    }
+
+    addGate();
+    put(row, gates.size() - 1);
+    return 0;
+  }
+
+public:
+  /**
+  * @brief Starts from the batch greedy's assignment of 'table'.
+  */
+  OnlineGateAssigner(const FlightTable& table, const vector<int>& gate) {
+    for (size_t i = 0; i < table.size(); i++) {
+      int g = gate[i] - 1; // Gates are numbered from 1
+      while (g >= (int)gates.size()) addGate();
+      const string& id = table.ids[table.idRef[i]];
+      rowOf[id] = flights.size();
+      ids.push_back(id);
+      flights.push_back({table.arrival[i], table.departure[i], -1});
+      put(flights.size() - 1, g);
+    }
+  }
+
+  // Each event returns the number of flights moved to another gate (including the flight
+  // itself when a delay forces it off its gate), or -1 if the event is invalid.
+  int delay(const string& id, int arrival, int departure) {
+    auto it = rowOf.find(id);
+    if (it == rowOf.end() || flights[it->second].gate < 0 || arrival >= departure) return -1;
+    int row = it->second, old = flights[row].gate;
+    take(row);
+    flights[row].arrival = arrival;
+    flights[row].departure = departure;
+    int moved = place(row, old);
+    return moved + (flights[row].gate != old);
+  }
+
+  int cancel(const string& id) {
+    auto it = rowOf.find(id);
+    if (it == rowOf.end() || flights[it->second].gate < 0) return -1;
+    take(it->second);
+    return 0;
+  }
+
+  int insert(const string& id, int arrival, int departure) {
+    if (arrival >= departure) return -1;
+    auto it = rowOf.find(id);
+    if (it != rowOf.end() && flights[it->second].gate >= 0) return -1; // Already scheduled
+    int row;
+    if (it != rowOf.end()) {
+      row = it->second; // A cancelled flight comes back
+    } else {
+      row = flights.size();
+      rowOf[id] = row;
+      ids.push_back(id);
+      flights.push_back({0, 0, -1});
+    }
+    flights[row].arrival = arrival;
+    flights[row].departure = departure;
+    return place(row, -1);
+  }
+
+  /**
+  * @brief Gates with at least one flight.
+  */
+  int gatesInUse() const {
+    int used = 0;
+    for (auto& g : gates) used += !g.empty();
+    return used;
+  }
+
+  /**
+  * @brief Live flights as a FlightTable (for recomputation or output); gate[i] is 1-based.
+  */
+  void snapshot(FlightTable& table, vector<int>& gate) const {
+    table = FlightTable();
+    gate.clear();
+    for (size_t r = 0; r < flights.size(); r++) {
+      if (flights[r].gate < 0) continue;
+      table.add(table.intern(ids[r].data(), ids[r].size()), flights[r].arrival, flights[r].departure);
+      gate.push_back(flights[r].gate + 1);
+    }
+  }
+
+  /**
+  * @brief Checks that every live flight sits on exactly its gate and no gate double-books.
+  */
+  bool consistent() const {
+    size_t live = 0, seated = 0;
+    for (auto& f : flights) live += f.gate >= 0;
+    for (int g = 0; g < (int)gates.size(); g++) {
+      int lastDeparture = INT_MIN;
+      for (auto& [arrival, row] : gates[g]) {
+        const Slot& f = flights[row];
+        if (f.gate != g || f.arrival != arrival || f.arrival < lastDeparture) return false;
+        lastDeparture = f.departure;
+        seated++;
+      }
+    }
+    return live == seated;
+  }
+};
+
+/**
+* @brief One schedule change from an event log:
+*   event,flight_id,arrival_time,departure_time
+*   delay,AI102,09:20,10:35
+*   cancel,SG411,,
+*   insert,XY123,14:00,15:00
+*/
+struct GateEvent {
+  char kind; // 'd'elay, 'c'ancel, 'i'nsert
+  string id;
+  int arrival, departure;
+};
+
+bool loadEvents(const string& path, vector<GateEvent>& events, long long& skipped) {
+  CsvLineReader in(path);
+  if (!in.ok()) return false;
+  const char* line;
+  size_t len;
+  skipped = 0;
+  in.next(line, len); // Skip header
+  while (in.next(line, len)) {
+    const char* f[4];
+    size_t fl[4];
+    int n = 0;
+    for (const char *p = line, *end = line + len; n < 4;) {
+      const char* c = (const char*)memchr(p, ',', end - p);
+      f[n] = p;
+      fl[n++] = (c ? c : end) - p;
+      if (!c) break;
+      p = c + 1;
+    }
+    if (n < 2 || fl[0] == 0 || (f[0][0] != 'd' && f[0][0] != 'c' && f[0][0] != 'i')) { skipped++; continue; }
+    GateEvent e{f[0][0], string(f[1], fl[1]), -1, -1};
+    if (e.kind != 'c') {
+      e.arrival = n == 4 ? parseMinutes(f[2], fl[2]) : -1;
+      e.departure = n == 4 ? parseMinutes(f[3], fl[3]) : -1;
+      if (e.arrival == -1 || e.departure == -1) { skipped++; continue; }
+    }
+    events.push_back(move(e));
+  }
+  return true;
+}
+
+int applyEvent(OnlineGateAssigner& gates, const GateEvent& e) {
+  switch (e.kind) {
+    case 'd': return gates.delay(e.id, e.arrival, e.departure);
+    case 'c': return gates.cancel(e.id);
+    default: return gates.insert(e.id, e.arrival, e.departure);
+  }
+}
+
+/**
+* @brief ./code online <flights.csv> <events.csv> [out.csv]: assigns the day's schedule, then
+* replays the event log against it.
+*/
+int runOnline(const string& flightsPath, const string& eventsPath, const string& outPath) {
+  FlightTable table;
+  vector<GateEvent> events;
+  long long skipped, badEvents;
+  if (!table.loadCSV(flightsPath, skipped)) { cerr << "Could not open " << flightsPath << "\n"; return 1; }
+  if (!loadEvents(eventsPath, events, badEvents)) { cerr << "Could not open " << eventsPath << "\n"; return 1; }
+  if (skipped) cerr << "Warning: skipped " << skipped << " flight(s) with invalid times.\n";
+  if (badEvents) cerr << "Warning: skipped " << badEvents << " malformed event(s).\n";
+
+  vector<uint32_t> order, counts;
+  vector<int> gate;
+  sortByArrival(table, order, counts);
+  cout << "Initial schedule: " << table.size() << " flights, " << assignGates(table, order, gate) << " gates\n";
+
+  OnlineGateAssigner online(table, gate);
+  long long moved = 0, rejected = 0;
+  for (auto& e : events) {
+    int m = applyEvent(online, e);
+    if (m < 0) { cerr << "Rejected event for " << e.id << " (unknown flight or invalid times)\n"; rejected++; }
+    else moved += m;
+  }
+  online.snapshot(table, gate);
+  cout << "Replayed " << events.size() << " event(s): " << moved << " flight(s) moved, " << rejected << " rejected\n";
+  cout << "Gates in use: " << online.gatesInUse() << "\n";
+
+  if (!outPath.empty()) {
+    sortByArrival(table, order, counts);
+    FILE* out = fopen(outPath.c_str(), "w");
+    if (!out) { cerr << "Could not write " << outPath << "\n"; return 1; }
+    fputs("flight_id,arrival_time,departure_time,gate\n", out);
+    for (uint32_t i : order)
+      fprintf(out, "%s,%02d:%02d,%02d:%02d,%d\n", table.ids[table.idRef[i]].c_str(), table.arrival[i] / 60,
+              table.arrival[i] % 60, table.departure[i] / 60, table.departure[i] % 60, gate[i]);
+    fclose(out);
+  }
+  return 0;
+}
+
+/**
+* @brief Records a synthetic event log for one busy day, replays it from disk and reports
+* per-event latency, flights moved and gate drift against recomputing from scratch.
+*/
+int runOnlineBenchmark(int numFlights, int numEvents) {
+  const string flightsPath = "/tmp/flights_day.csv", eventsPath = "/tmp/gate_events.csv";
+  mt19937 rng(7);
+  uniform_int_distribution<int> arrival(5 * 60, 22 * 60), stay(30, 150), shift(5, 90), pct(0, 99);
+  vector<string> live;
+  {
+    FILE* out = fopen(flightsPath.c_str(), "w");
+    if (!out) { cerr << "Could not write " << flightsPath << "\n"; return 1; }
+    fputs("flight_id,arrival_time,departure_time\n", out);
+    for (int i = 0; i < numFlights; i++) {
+      int a = arrival(rng), d = a + stay(rng);
+      fprintf(out, "F%d,%02d:%02d,%02d:%02d\n", i, a / 60, a % 60, d / 60, d % 60);
+      live.push_back("F" + to_string(i));
+    }
+    fclose(out);
+
+    // 70% delays (arrival and departure pushed back together), 15% cancels, 15% inserts.
+    out = fopen(eventsPath.c_str(), "w");
+    fputs("event,flight_id,arrival_time,departure_time\n", out);
+    int inserted = 0;
+    for (int i = 0; i < numEvents; i++) {
+      int p = pct(rng), a = arrival(rng), d = a + stay(rng);
+      if (p < 85 && !live.empty()) {
+        size_t k = rng() % live.size();
+        if (p < 70) {
+          int late = shift(rng);
+          a = min(a + late, 23 * 60);
+          d = a + stay(rng);
+          fprintf(out, "delay,%s,%02d:%02d,%02d:%02d\n", live[k].c_str(), a / 60, a % 60, d / 60, d % 60);
+        } else {
+          fprintf(out, "cancel,%s,,\n", live[k].c_str());
+          swap(live[k], live.back());
+          live.pop_back();
+        }
+      } else {
+        live.push_back("X" + to_string(inserted++));
+        fprintf(out, "insert,%s,%02d:%02d,%02d:%02d\n", live.back().c_str(), a / 60, a % 60, d / 60, d % 60);
+      }
+    }
+    fclose(out);
+  }
+
+  FlightTable table;
+  vector<GateEvent> events;
+  long long skipped;
+  table.loadCSV(flightsPath, skipped);
+  loadEvents(eventsPath, events, skipped);
+  vector<uint32_t> order, counts;
+  vector<int> gate;
+  sortByArrival(table, order, counts);
+  int initialGates = assignGates(table, order, gate);
+  OnlineGateAssigner online(table, gate);
+  printf("Day schedule: %zu flights on %d gates, replaying %zu events\n\n", table.size(), initialGates, events.size());
+
+  vector<double> micros(events.size());
+  long long moved = 0, rejected = 0;
+  auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < events.size(); i++) {
+    auto t0 = chrono::steady_clock::now();
+    int m = applyEvent(online, events[i]);
+    micros[i] = msSince(t0) * 1000;
+    if (m < 0) rejected++; else moved += m;
+  }
+  double totalMs = msSince(start);
+  sort(micros.begin(), micros.end());
+  printf("Event latency: p50 %.2f us, p99 %.2f us, max %.2f us (%.0f events/s)\n", micros[micros.size() / 2],
+         micros[micros.size() * 99 / 100], micros.back(), events.size() / (totalMs / 1000));
+  printf("Flights moved: %lld (%.3f per event), %lld event(s) rejected\n", moved, (double)moved / events.size(), rejected);
+
+  // Baseline: re-sorting and re-running the greedy for the live schedule after an event.
+  FlightTable now;
+  vector<int> nowGate;
+  online.snapshot(now, nowGate);
+  const int rounds = 100;
+  int optimal = 0;
+  auto t0 = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    sortByArrival(now, order, counts);
+    optimal = assignGates(now, order, nowGate);
+  }
+  printf("Full recomputation: %.2f us per event; needs %d gates vs %d in use online\n",
+         msSince(t0) * 1000 / rounds, optimal, online.gatesInUse());
+
+  bool ok = online.consistent();
+  printf("\nFinal assignment %s\n", ok ? "consistent (no double-booked gate)" : "INCONSISTENT");
+  remove(flightsPath.c_str());
+  remove(eventsPath.c_str());
+  return ok ? 0 : 1;
+}
+
+// --- Multi-Day, Multi-Terminal Scheduling ---
+// Season files add a terminal and an aircraft size class per flight, and times may carry
+// a date so stays can run past midnight:
+//   flight_id,terminal,class,arrival,departure
+//   AI102,T1,narrow,2024-05-01 23:10,2024-05-02 00:40
+// (plain "HH:MM" means the first day). A flight may only use gates of its own class in its
+// own terminal, so every (terminal, class) pair is an independent gate pool. Each pool is
+// further split into one job per arrival day: aircraft still parked at midnight are seeded
+// into that day's job as gates busy until they leave, so jobs need nothing from each other
+// and run in parallel. A sequential stitch pass then renames each day's gates so the
+// parked aircraft keep their gate from the previous day. Every job runs the same greedy as
+// assignGates, so the gates per pool equal the exact minimum (the largest overlap).
+
+/**
+* @brief Days since 1970-01-01 for a civil date (proleptic Gregorian).
+*/
+long long daysFromCivil(long long y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  long long era = (y >= 0 ? y : y - 399) / 400;
+  unsigned yoe = (unsigned)(y - era * 400);
+  unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (long long)doe - 719468;
+}
+
+void civilFromDays(long long z, int& y, int& m, int& d) {
+  z += 719468;
+  long long era = (z >= 0 ? z : z - 146096) / 146097;
+  unsigned doe = (unsigned)(z - era * 146097);
+  unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  unsigned mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y = (int)(yoe + era * 400) + (m <= 2);
+}
+
+/**
+* @brief Parses "YYYY-MM-DD HH:MM" (or "YYYY-MM-DDTHH:MM") into minutes since 1970-01-01, or
+* plain "HH:MM" into minutes of day 0 (the caller places it on the schedule's first day).
+* Returns LLONG_MIN on failure.
+*/
+long long parseDateTime(const char* s, size_t len) {
+  if (len == 5) {
+    int m = parseMinutes(s, len);
+    return m < 0 ? LLONG_MIN : m;
+  }
+  if (len != 16 || s[4] != '-' || s[7] != '-' || (s[10] != ' ' && s[10] != 'T')) return LLONG_MIN;
+  int v[3] = {0, 0, 0};
+  const int start[3] = {0, 5, 8}, digits[3] = {4, 2, 2};
+  for (int f = 0; f < 3; f++)
+    for (int i = start[f]; i < start[f] + digits[f]; i++) {
+      if (s[i] < '0' || s[i] > '9') return LLONG_MIN;
+      v[f] = v[f] * 10 + (s[i] - '0');
+    }
+  int minutes = parseMinutes(s + 11, 5);
+  if (minutes < 0 || v[1] < 1 || v[1] > 12 || v[2] < 1 || v[2] > 31) return LLONG_MIN;
+  return daysFromCivil(v[0], v[1], v[2]) * 1440 + minutes;
+}
+
+/**
+* @brief Monotonic bump allocator owned by one worker. reset() rewinds it for the next job
+* while keeping its blocks, so steady-state jobs never touch the global heap.
+*/
+class Arena {
+  vector<unique_ptr<char[]>> blocks;
+  vector<size_t> sizes;
+  size_t block = 0, used = 0;
+
+public:
+  void* allocate(size_t bytes, size_t align) {
+    while (true) {
+      if (block < blocks.size()) {
+        size_t at = (used + align - 1) & ~(align - 1);
+        if (at + bytes <= sizes[block]) { used = at + bytes; return blocks[block].get() + at; }
+        block++;
+        used = 0;
+        continue;
+      }
+      size_t size = max<size_t>(bytes + align, sizes.empty() ? 1 << 16 : sizes.back() * 2);
+      blocks.emplace_back(new char[size]);
+      sizes.push_back(size);
+    }
+  }
+  void reset() { block = 0; used = 0; }
+};
+
+template <class T>
+struct ArenaAllocator {
+  using value_type = T;
+  Arena* arena;
+  explicit ArenaAllocator(Arena& a) : arena(&a) {}
+  template <class U> ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+  T* allocate(size_t n) { return (T*)arena->allocate(n * sizeof(T), alignof(T)); }
+  void deallocate(T*, size_t) {} // Freed all at once by Arena::reset
+  bool operator==(const ArenaAllocator& o) const { return arena == o.arena; }
+  bool operator!=(const ArenaAllocator& o) const { return arena != o.arena; }
+};
+
+template <class T>
+using ArenaVector = vector<T, ArenaAllocator<T>>;
+
+/**
+* @brief Season schedule: the FlightTable columns plus terminal and class per flight.
+* Times are minutes since midnight of the first day in the file.
+*/
+struct SeasonTable {
+  FlightTable flights;
+  vector<uint16_t> terminal, gateClass;
+  vector<string> terminalNames, classNames;
+  unordered_map<string, uint16_t> terminalIndex, classIndex;
+  long long firstDay = 0; // Days since 1970-01-01 of day 0 (0 if the file had no dates)
+  bool dated = false;
+
+  size_t size() const { return flights.size(); }
+
+  static uint16_t name(const char* s, size_t len, vector<string>& names, unordered_map<string, uint16_t>& index) {
+    auto it = index.emplace(string(s, len), names.size());
+    if (it.second) names.emplace_back(s, len);
+    return it.first->second;
+  }
+
+  bool loadCSV(const string& path, long long& skipped) {
+    CsvLineReader in(path);
+    if (!in.ok()) return false;
+    const char* line;
+    size_t len;
+    vector<long long> arr, dep;
+    vector<char> bare; // Bit 0: arrival was plain HH:MM, bit 1: departure was
+    skipped = 0;
+    in.next(line, len); // Skip header
+    while (in.next(line, len)) {
+      const char* f[5];
+      size_t fl[5];
+      int n = 0;
+      for (const char *p = line, *end = line + len; n < 5;) {
+        const char* c = (const char*)memchr(p, ',', end - p);
+        f[n] = p;
+        fl[n++] = (c ? c : end) - p;
+        if (!c) break;
+        p = c + 1;
+      }
+      long long a = n == 5 ? parseDateTime(f[3], fl[3]) : LLONG_MIN;
+      long long d = n == 5 ? parseDateTime(f[4], fl[4]) : LLONG_MIN;
+      if (a == LLONG_MIN || d == LLONG_MIN) { skipped++; continue; }
+      dated = dated || fl[3] == 16 || fl[4] == 16;
+      flights.idRef.push_back(flights.intern(f[0], fl[0]));
+      terminal.push_back(name(f[1], fl[1], terminalNames, terminalIndex));
+      gateClass.push_back(name(f[2], fl[2], classNames, classIndex));
+      arr.push_back(a);
+      dep.push_back(d);
+      bare.push_back((fl[3] == 5) | (fl[4] == 5) << 1);
+    }
+    long long first = LLONG_MAX;
+    for (size_t i = 0; i < arr.size(); i++) {
+      if (!(bare[i] & 1)) first = min(first, arr[i] / 1440);
+      if (!(bare[i] & 2)) first = min(first, dep[i] / 1440);
+    }
+    firstDay = dated ? first : 0;
+
+    // Rows are only checked once every time is on the same clock.
+    size_t k = 0;
+    for (size_t i = 0; i < arr.size(); i++) {
+      int a = (int)(bare[i] & 1 ? arr[i] : arr[i] - firstDay * 1440);
+      int d = (int)(bare[i] & 2 ? dep[i] : dep[i] - firstDay * 1440);
+      if (a >= d) { skipped++; continue; }
+      flights.idRef[k] = flights.idRef[i];
+      terminal[k] = terminal[i];
+      gateClass[k++] = gateClass[i];
+      flights.arrival.push_back(a);
+      flights.departure.push_back(d);
+    }
+    flights.idRef.resize(k);
+    terminal.resize(k);
+    gateClass.resize(k);
+    return true;
+  }
+
+  string formatTime(int minutes) const {
+    char buf[32];
+    if (!dated && minutes < 1440) {
+      snprintf(buf, sizeof buf, "%02d:%02d", minutes / 60, minutes % 60);
+    } else {
+      int y, m, d;
+      civilFromDays(firstDay + minutes / 1440, y, m, d);
+      snprintf(buf, sizeof buf, "%04d-%02d-%02d %02d:%02d", y, m, d, minutes % 1440 / 60, minutes % 60);
+    }
+    return buf;
+  }
+};
+
+/**
+* @brief Gate pools and per-flight gates for a SeasonTable.
+*/
+struct SeasonSchedule {
+  int days = 0;
+  vector<int> gatesPerPool; // Pool (terminal * classes + class) -> gates needed
+  vector<int> gate;         // Row -> gate number within its pool, from 1
+  double partitionMs = 0, jobsMs = 0, stitchMs = 0;
+};
+
+/**
+* @brief Runs the greedy for one (terminal, class, day) job: 'carry' rows are parked at the
+* start of the day and take local gates 0 .. carry-1; 'rows' arrive that day.
+*/
+int scheduleDay(const SeasonTable& t, const uint32_t* rows, size_t n, const uint32_t* carry, size_t c,
+                int dayStart, Arena& arena, vector<int>& localGate) {
+  arena.reset();
+  const auto& arrival = t.flights.arrival;
+  const auto& departure = t.flights.departure;
+
+  // Stable counting sort of the day's arrivals by minute of day.
+  ArenaVector<uint32_t> counts(1441, 0, ArenaAllocator<uint32_t>(arena));
+  ArenaVector<uint32_t> order(n, 0, ArenaAllocator<uint32_t>(arena));
+  for (size_t i = 0; i < n; i++) counts[arrival[rows[i]] - dayStart + 1]++;
+  for (int m = 0; m < 1440; m++) counts[m + 1] += counts[m];
+  for (size_t i = 0; i < n; i++) order[counts[arrival[rows[i]] - dayStart]++] = rows[i];
+
+  typedef pair<int,int> Busy; // (departure, local gate)
+  ArenaVector<Busy> storage{ArenaAllocator<Busy>(arena)};
+  storage.reserve(c + 64);
+  priority_queue<Busy, ArenaVector<Busy>, greater<Busy>> gateHeap(greater<Busy>(), move(storage));
+  int gateCount = 0;
+  for (size_t i = 0; i < c; i++) gateHeap.push({departure[carry[i]], gateCount++});
+  for (uint32_t r : order) {
+    if (!gateHeap.empty() && gateHeap.top().first <= arrival[r]) {
+      int g = gateHeap.top().second;
+      gateHeap.pop();
+      gateHeap.push({departure[r], g});
+      localGate[r] = g;
+    } else {
+      gateHeap.push({departure[r], gateCount});
+      localGate[r] = gateCount++;
+    }
+  }
+  return gateCount;
+}
+
+/**
+* @brief Schedules every (terminal, class) pool over all days with 'threads' workers.
+*/
+void scheduleSeason(const SeasonTable& t, int threads, SeasonSchedule& out) {
+  auto t0 = chrono::steady_clock::now();
+  size_t n = t.size();
+  int classes = t.classNames.size(), pools = t.terminalNames.size() * classes;
+  int days = 0;
+  for (size_t i = 0; i < n; i++) days = max(days, t.flights.arrival[i] / 1440 + 1);
+  out.days = days;
+
+  // Group rows by job = pool * days + arrival day (counting sort), and list the rows parked
+  // overnight into each later day of their stay.
+  size_t jobs = (size_t)pools * days;
+  vector<uint32_t> jobStart(jobs + 1, 0), rows(n), carryStart(jobs + 1, 0), carry;
+  auto jobOf = [&](size_t i, int day) { return ((size_t)t.terminal[i] * classes + t.gateClass[i]) * days + day; };
+  for (size_t i = 0; i < n; i++) {
+    jobStart[jobOf(i, t.flights.arrival[i] / 1440) + 1]++;
+    for (int d = t.flights.arrival[i] / 1440 + 1; d * 1440 < t.flights.departure[i] && d < days; d++) carryStart[jobOf(i, d) + 1]++;
+  }
+  for (size_t j = 0; j < jobs; j++) { jobStart[j + 1] += jobStart[j]; carryStart[j + 1] += carryStart[j]; }
+  carry.resize(carryStart[jobs]);
+  {
+    vector<uint32_t> fillRows(jobStart.begin(), jobStart.end() - 1), fillCarry(carryStart.begin(), carryStart.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+      rows[fillRows[jobOf(i, t.flights.arrival[i] / 1440)]++] = i;
+      for (int d = t.flights.arrival[i] / 1440 + 1; d * 1440 < t.flights.departure[i] && d < days; d++)
+        carry[fillCarry[jobOf(i, d)]++] = i;
+    }
+  }
+  out.partitionMs = msSince(t0);
+
+  // Parallel phase: workers pull jobs from a shared counter, each with its own arena.
+  t0 = chrono::steady_clock::now();
+  vector<int> localGate(n), jobGates(jobs, 0);
+  atomic<size_t> nextJob{0};
+  auto worker = [&] {
+    Arena arena;
+    for (size_t j; (j = nextJob++) < jobs;) {
+      // Days with only parked aircraft still need their carried gates labelled.
+      if (jobStart[j] == jobStart[j + 1] && carryStart[j] == carryStart[j + 1]) continue;
+      jobGates[j] = scheduleDay(t, rows.data() + jobStart[j], jobStart[j + 1] - jobStart[j], carry.data() + carryStart[j],
+                                carryStart[j + 1] - carryStart[j], (int)(j % days) * 1440, arena, localGate);
+    }
+  };
+  vector<thread> pool;
+  for (int w = 1; w < threads; w++) pool.emplace_back(worker);
+  worker();
+  for (auto& th : pool) th.join();
+  out.jobsMs = msSince(t0);
+
+  // Stitch: day by day, parked aircraft keep yesterday's gate and the day's other local
+  // gates take the lowest numbers still free.
+  t0 = chrono::steady_clock::now();
+  out.gate.assign(n, 0);
+  out.gatesPerPool.assign(pools, 0);
+  vector<int> label;
+  vector<char> taken;
+  for (size_t j = 0; j < jobs; j++) {
+    size_t c = carryStart[j + 1] - carryStart[j];
+    int& poolGates = out.gatesPerPool[j / days];
+    label.assign(jobGates[j], 0);
+    taken.assign(max(poolGates, jobGates[j]) + 2, 0); // Yesterday's labels go up to poolGates
+    for (size_t i = 0; i < c; i++) {
+      label[i] = out.gate[carry[carryStart[j] + i]];
+      taken[label[i]] = 1;
+    }
+    for (int g = c, next = 1; g < jobGates[j]; g++) {
+      while (taken[next]) next++;
+      label[g] = next++;
+    }
+    for (uint32_t k = jobStart[j]; k < jobStart[j + 1]; k++) out.gate[rows[k]] = label[localGate[rows[k]]];
+    poolGates = max(poolGates, jobGates[j]);
+  }
+  out.stitchMs = msSince(t0);
+}
+
+/**
+* @brief Checks that no gate of any pool is double-booked and gate numbers stay within the
+* pool's reported count.
+*/
+bool validSchedule(const SeasonTable& t, const SeasonSchedule& s) {
+  int classes = t.classNames.size();
+  vector<uint32_t> rows(t.size());
+  for (uint32_t i = 0; i < rows.size(); i++) rows[i] = i;
+  auto pool = [&](uint32_t i) { return t.terminal[i] * classes + t.gateClass[i]; };
+  sort(rows.begin(), rows.end(), [&](uint32_t a, uint32_t b) {
+    return make_tuple(pool(a), s.gate[a], t.flights.arrival[a]) < make_tuple(pool(b), s.gate[b], t.flights.arrival[b]);
+  });
+  for (size_t k = 0; k < rows.size(); k++) {
+    uint32_t i = rows[k];
+    if (s.gate[i] < 1 || s.gate[i] > s.gatesPerPool[pool(i)]) return false;
+    if (k && pool(rows[k - 1]) == pool(i) && s.gate[rows[k - 1]] == s.gate[i] &&
+        t.flights.departure[rows[k - 1]] > t.flights.arrival[i])
+      return false;
+  }
+  return true;
+}
+
+/**
+* @brief ./code schedule <season.csv> [threads] [out.csv]
+*/
+int runSeason(const string& inPath, int threads, const string& outPath) {
+  SeasonTable table;
+  long long skipped;
+  if (!table.loadCSV(inPath, skipped)) { cerr << "Could not open " << inPath << "\n"; return 1; }
+  if (skipped) cerr << "Warning: skipped " << skipped << " flight(s) with invalid times.\n";
+
+  SeasonSchedule s;
+  scheduleSeason(table, threads, s);
+  cout << "Flights: " << table.size() << " over " << s.days << " day(s)\n";
+  cout << "Minimum gates per terminal and class:\n";
+  for (size_t term = 0; term < table.terminalNames.size(); term++)
+    for (size_t c = 0; c < table.classNames.size(); c++)
+      cout << "  " << table.terminalNames[term] << " / " << table.classNames[c] << ": "
+           << s.gatesPerPool[term * table.classNames.size() + c] << "\n";
+
+  if (!outPath.empty()) {
+    FILE* out = fopen(outPath.c_str(), "w");
+    if (!out) { cerr << "Could not write " << outPath << "\n"; return 1; }
+    fputs("flight_id,terminal,class,arrival,departure,gate\n", out);
+    for (size_t i = 0; i < table.size(); i++)
+      fprintf(out, "%s,%s,%s,%s,%s,%d\n", table.flights.ids[table.flights.idRef[i]].c_str(),
+              table.terminalNames[table.terminal[i]].c_str(), table.classNames[table.gateClass[i]].c_str(),
+              table.formatTime(table.flights.arrival[i]).c_str(), table.formatTime(table.flights.departure[i]).c_str(),
+              s.gate[i]);
+    fclose(out);
+  }
+  return 0;
+}
+
+/**
+* @brief Fixed season where a wide-body stays parked through a day with no wide-body arrivals
+* (a carry-only job); checks its gate survives the stitch and the day after needs two gates.
+*/
+bool overnightParkCheck() {
+  const string path = "/tmp/season_overnight.csv";
+  FILE* out = fopen(path.c_str(), "w");
+  if (!out) return false;
+  fputs("flight_id,terminal,class,arrival,departure\n"
+        "W1,T1,wide,2024-05-01 10:00,2024-05-03 09:00\n"
+        "N1,T1,narrow,2024-05-02 12:00,2024-05-02 13:00\n"
+        "W2,T1,wide,2024-05-03 08:00,2024-05-03 10:00\n"
+        "W3,T1,wide,2024-05-03 09:30,2024-05-03 11:00\n", out);
+  fclose(out);
+  SeasonTable table;
+  long long skipped;
+  bool ok = table.loadCSV(path, skipped) && skipped == 0;
+  remove(path.c_str());
+  if (!ok) return false;
+  for (int threads : {1, 2}) {
+    SeasonSchedule s;
+    scheduleSeason(table, threads, s);
+    int wide = table.terminal[0] * table.classNames.size() + table.gateClass[0];
+    if (!validSchedule(table, s) || s.gatesPerPool[wide] != 2) return false;
+  }
+  return true;
+}
+
+/**
+* @brief Synthetic multi-day season; schedules it with 1, 2, 4, ... threads and checks the
+* gate counts against one whole-horizon greedy per pool.
+*/
+int runSeasonBenchmark(int numFlights, int days, int terminals) {
+  const string path = "/tmp/season_bench.csv";
+  const char* classes[] = {"regional", "narrow", "wide"};
+  {
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out) { cerr << "Could not write " << path << "\n"; return 1; }
+    mt19937 rng(3);
+    uniform_int_distribution<int> day(0, days - 1), minute(0, 1439), pct(0, 99);
+    fputs("flight_id,terminal,class,arrival,departure\n", out);
+    long long base = daysFromCivil(2024, 5, 1);
+    for (int i = 0; i < numFlights; i++) {
+      int p = pct(rng), cls = p < 30 ? 0 : p < 85 ? 1 : 2;
+      long long a = (base + day(rng)) * 1440 + minute(rng);
+      long long d = a + 25 + rng() % (cls == 2 ? 240 : 120) + (pct(rng) < 2 ? 600 : 0); // Some overnight stays
+      int ya, ma, da, yd, md, dd;
+      civilFromDays(a / 1440, ya, ma, da);
+      civilFromDays(d / 1440, yd, md, dd);
+      fprintf(out, "F%d,T%d,%s,%04d-%02d-%02d %02lld:%02lld,%04d-%02d-%02d %02lld:%02lld\n", i, (int)(rng() % terminals) + 1,
+              classes[cls], ya, ma, da, a % 1440 / 60, a % 60, yd, md, dd, d % 1440 / 60, d % 60);
+    }
+    fclose(out);
+  }
+
+  SeasonTable table;
+  long long skipped;
+  auto t0 = chrono::steady_clock::now();
+  table.loadCSV(path, skipped);
+  printf("Season: %zu flights, %d terminals x %zu classes, %d days (loaded in %.1f ms)\n\n", table.size(), terminals,
+         table.classNames.size(), days, msSince(t0));
+
+  // Reference: one greedy over the whole horizon per pool, no day split.
+  int pools = table.terminalNames.size() * table.classNames.size();
+  vector<int> reference(pools, 0);
+  {
+    vector<vector<uint32_t>> byPool(pools);
+    for (uint32_t i = 0; i < table.size(); i++) byPool[table.terminal[i] * table.classNames.size() + table.gateClass[i]].push_back(i);
+    for (int p = 0; p < pools; p++) {
+      sort(byPool[p].begin(), byPool[p].end(), [&](uint32_t a, uint32_t b) { return table.flights.arrival[a] < table.flights.arrival[b]; });
+      vector<int> gate(table.size());
+      reference[p] = assignGates(table.flights, byPool[p], gate);
+    }
+  }
+
+  int maxThreads = max(1u, thread::hardware_concurrency());
+  int mismatches = overnightParkCheck() ? 0 : 1;
+  printf("%d hardware thread(s) available\n", maxThreads);
+  printf("%-8s %14s %12s %12s %16s\n", "threads", "partition ms", "jobs ms", "stitch ms", "flights/sec");
+  for (int threads = 1; threads <= max(8, maxThreads); threads *= 2) {
+    SeasonSchedule s;
+    scheduleSeason(table, threads, s);
+    double total = s.partitionMs + s.jobsMs + s.stitchMs;
+    printf("%-8d %14.1f %12.1f %12.1f %16.0f\n", threads, s.partitionMs, s.jobsMs, s.stitchMs, table.size() / (total / 1000));
+    if (s.gatesPerPool != reference || !validSchedule(table, s)) mismatches++;
+  }
+
+  printf("\nMinimum gates per class (summed over terminals):");
+  for (size_t c = 0; c < table.classNames.size(); c++) {
+    int sum = 0;
+    for (size_t term = 0; term < table.terminalNames.size(); term++) sum += reference[term * table.classNames.size() + c];
+    printf(" %s %d%s", table.classNames[c].c_str(), sum, c + 1 < table.classNames.size() ? "," : "\n");
+  }
+  printf("%d mismatch(es) against the whole-horizon greedy / double-booking check\n", mismatches);
+  remove(path.c_str());
+  return mismatches == 0 ? 0 : 1;
+}
+
 // --- Main Algorithm Implementation ---
 
-int main() {
+int main(int argc, char* argv[]) {
+  if (argc > 2 && string(argv[1]) == "batch") {
+    return runBatch(argv[2], argc > 3 ? argv[3] : "");
+  }
+  if (argc > 3 && string(argv[1]) == "online") {
+    return runOnline(argv[2], argv[3], argc > 4 ? argv[4] : "");
+  }
+  if (argc > 1 && string(argv[1]) == "online-bench") {
+    return runOnlineBenchmark(argc > 2 ? atoi(argv[2]) : 2000, argc > 3 ? atoi(argv[3]) : 100000);
+  }
+  if (argc > 2 && string(argv[1]) == "schedule") {
+    return runSeason(argv[2], argc > 3 ? atoi(argv[3]) : (int)max(1u, thread::hardware_concurrency()), argc > 4 ? argv[4] : "");
+  }
+  if (argc > 1 && string(argv[1]) == "schedule-bench") {
+    return runSeasonBenchmark(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 90, argc > 4 ? atoi(argv[4]) : 4);
+  }
+  if (argc > 1 && string(argv[1]) == "bench") {
+    return runBenchmark(argc > 2 ? atoi(argv[2]) : 1000000);
+  }
  
   vector<Flight> flights;
   int numFlights;
@@ -173,32 +1491,9 @@ int main() {
   // 2. Greedy Strategy Step 1: Sort by Arrival Time using MERGE SORT
   mergeSort(flights, 0, flights.size() - 1);
 
-  // 3. Greedy Strategy Step 2: Initialize Gate Tracking Structures (Unchanged)
- 
-  // Min-Heap (Priority Queue): Stores the availability time (<Departure_Time, Gate_Number>)
-  // The top element is the earliest free gate.
-  priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> gateHeap;
-
-  int gateCount = 0; // Tracks the minimum number of gates used
+  // 3. Greedy Strategy Step 2: Assign gates with the Min-Heap (see assignGates)
   unordered_map<string,int> flightGate; // Maps flight ID to its assigned gate number
-
-  // 4. Process Flights and Assign Gates (Unchanged - The core Greedy logic)
-  for (const auto &f : flights) {
-   
-    if (!gateHeap.empty() && gateHeap.top().first <= f.arrival) {
-      // REUSE GATE: The earliest available gate is free before the current flight arrives.
-      int gateNum = gateHeap.top().second;
-      gateHeap.pop();
-      gateHeap.push({f.departure, gateNum}); // Update availability time
-      flightGate[f.id] = gateNum;
-     
-    } else {
-      // NEW GATE: No gate is available, so a new one is required.
-      gateCount++;
-      gateHeap.push({f.departure, gateCount}); // Add new gate with its release time
-      flightGate[f.id] = gateCount;
-    }
-  }
+  int gateCount = assignGates(flights, flightGate);
 
   // 5. Output Results (Unchanged)
  
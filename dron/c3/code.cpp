@@ -6,12 +6,32 @@
 
     The code is fully scalable — larger datasets, real city layouts, or CSV-based
     inputs can be integrated without changing the core Segment Tree logic.
+
+    Usage:
+        ./code                              interactive session, statuses typed in
+        ./code bench [plots ops]            range assign vs the per-plot update loop
+        ./code convert <plots.csv> <plots.bin>   one-time conversion to a registry file
+        ./code registry <plots.bin>         menu over the persistent, journaled registry
+        ./code registry-bench [plots updates]    startup time, update throughput, recovery
+        ./code grid <plots.bin> <width>     count free plots in map rectangles
+        ./code grid-bench [parcels ops]     2D index: row-major vs Z-order layout
 */
 
 #include <iostream>
 #include <vector>
+#include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace std;
 
@@ -111,22 +131,997 @@ int query(int node, int start, int end, int L, int R) {
     return p1 + p2;
 }
 
+// --- Range Allocation Tree (lazy propagation) ---
+
+/**
+ * @brief Segment tree over the plots with range assign and "first free block" search.
+ * Iterative bottom-up layout of 2N entries: plot p is leaf N + p and node i has children 2i
+ * and 2i+1, so no recursion is needed. N is not rounded up, so a few nodes near the top
+ * straddle the end of the array and hold meaningless values; range operations only touch
+ * whole aligned nodes, and the free-run search starts from the O(log N) nodes that cover
+ * [0, N) rather than from the root.
+ * Each internal node stores, for its block, the free-plot count, the free run at its left end,
+ * the free run at its right end and the longest free run anywhere inside it; a leaf is just
+ * its status byte. A pending "set whole block to free/occupied" tag on internal nodes is
+ * pushed to the children only when a later operation needs to look inside the block.
+ */
+class PlotTree {
+    struct Node {
+        int free, prefix, suffix, best;
+    };
+    int n = 0, height = 0;
+    vector<Node> t;                 // Internal nodes 1 .. N-1
+    vector<unsigned char> occupied; // Leaves N .. 2N-1
+    vector<signed char> pending;    // -1: none, 0: whole block free, 1: whole block occupied
+
+    // Plots under node i (meaningful for aligned nodes only).
+    int length(int i) const {
+        if (i >= n) return 1;
+        int s = __builtin_clz(i) - __builtin_clz(n); // i << s has as many bits as n
+        return (i << s) >= n ? 1 << s : 2 << s;
+    }
+
+    Node node(int i) const {
+        if (i < n) return t[i];
+        int v = !occupied[i - n];
+        return {v, v, v, v};
+    }
+
+    // Sets node i's whole block to 'status'.
+    void apply(int i, int status) {
+        if (i >= n) { occupied[i - n] = status; return; }
+        int v = status == 0 ? length(i) : 0;
+        t[i] = {v, v, v, v};
+        pending[i] = status;
+    }
+
+    // Recomputes internal node i from its children (or from its own tag, if it has one).
+    void pull(int i) {
+        if (pending[i] != -1) { apply(i, pending[i]); return; }
+        Node a = node(2 * i), b = node(2 * i + 1);
+        int half = length(i) / 2;
+        t[i].free = a.free + b.free;
+        t[i].prefix = a.prefix == half ? half + b.prefix : a.prefix;
+        t[i].suffix = b.suffix == half ? half + a.suffix : b.suffix;
+        t[i].best = max({a.best, b.best, a.suffix + b.prefix});
+    }
+
+    void pushNode(int i) {
+        if (pending[i] == -1) return;
+        apply(2 * i, pending[i]);
+        apply(2 * i + 1, pending[i]);
+        pending[i] = -1;
+    }
+
+    // Pushes every tag on the path from the top down to leaf 'leaf'.
+    void pushPath(int leaf) {
+        for (int s = height; s > 0; --s) pushNode(leaf >> s);
+    }
+
+    void pullPath(int leaf) {
+        while (leaf > 1) pull(leaf >>= 1);
+    }
+
+    // Leftmost run of k free plots inside aligned node i, whose first plot is 'first'.
+    int descend(int i, int k, int first) {
+        while (i < n) {
+            pushNode(i);
+            Node a = node(2 * i), b = node(2 * i + 1);
+            int half = length(i) / 2;
+            if (a.best >= k) {
+                i = 2 * i;
+            } else if (a.suffix + b.prefix >= k) {
+                return first + half - a.suffix;
+            } else {
+                i = 2 * i + 1;
+                first += half;
+            }
+        }
+        return first;
+    }
+
+public:
+    /**
+     * @brief Builds the tree from a 0/1 status array in O(N).
+     */
+    void build(const vector<int>& status) {
+        n = status.size();
+        height = n ? 32 - __builtin_clz(n) : 0;
+        t.assign(n, {0, 0, 0, 0});
+        pending.assign(n, -1);
+        occupied.resize(n);
+        for (int i = 0; i < n; i++) occupied[i] = status[i] != 0;
+        for (int i = n - 1; i > 0; --i) pull(i);
+    }
+
+    /**
+     * @brief Range Assign: marks every plot in [L, R] occupied (1) or free (0).
+     * Time Complexity: O(log N)
+     */
+    void assign(int L, int R, int status) {
+        int l = L + n, r = R + n + 1;
+        pushPath(l);
+        pushPath(r - 1);
+        for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) apply(a++, status);
+            if (b & 1) apply(--b, status);
+        }
+        pullPath(l);
+        pullPath(r - 1);
+    }
+
+    /**
+     * @brief Range Query: number of free plots in [L, R].
+     * Time Complexity: O(log N)
+     */
+    int countFree(int L, int R) {
+        int l = L + n, r = R + n + 1, sum = 0;
+        pushPath(l);
+        pushPath(r - 1);
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) sum += node(l++).free;
+            if (r & 1) sum += node(--r).free;
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Index of the first plot of the leftmost run of k contiguous free plots, or -1.
+     * Walks the aligned nodes covering [0, N) left to right, carrying the free run that ends
+     * at the current boundary; the run either reaches into the next node's prefix or lies
+     * inside one node, which is then searched top-down. Time Complexity: O(log N)
+     */
+    int findFreeRun(int k) {
+        if (k <= 0 || k > n) return -1;
+        int l = n, r = 2 * n;
+        pushPath(l);
+        pushPath(r - 1);
+        int cover[64], count = 0, rightSide[32], rightCount = 0;
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) cover[count++] = l++;
+            if (r & 1) rightSide[rightCount++] = --r;
+        }
+        while (rightCount) cover[count++] = rightSide[--rightCount]; // Right-side nodes come last, reversed
+        int first = 0, run = 0; // Free plots just before 'first'
+        for (int j = 0; j < count; j++) {
+            int i = cover[j], len = length(i);
+            Node c = node(i);
+            if (run + c.prefix >= k) return first - run;
+            if (c.best >= k) return descend(i, k, first);
+            run = c.prefix == len ? run + len : c.suffix;
+            first += len;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Status of a single plot (0 free, 1 occupied).
+     */
+    int status(int idx) {
+        pushPath(idx + n);
+        return occupied[idx];
+    }
+
+    int plotCount() const { return n; }
+    size_t memoryBytes() const { return t.size() * sizeof(Node) + occupied.size() + pending.size(); }
+};
+
+// --- Persistent Plot Registry (memory-mapped bitset + journal) ---
+// The registry file holds one bit per plot (1 = occupied) after a 16-byte header:
+//   "PLOTREG1" | uint64 plot count | uint64 words[ceil(N / 64)]
+// It is memory-mapped shared, so allocations go straight to the page cache and survive a
+// restart without re-entering anything. The segment tree is kept in memory only: each leaf
+// summarises a 512-plot block of 8 words (free count from popcount, end runs from ctz/clz),
+// so rebuilding it at startup is one linear pass over N/64 words and the tree stays small
+// (about 1/16 of the bitset size).
+// Every range update is first appended to "<file>.journal" as a checksummed record and then
+// applied to the mapped bits. Opening the registry replays the journal (assigns are
+// idempotent, a torn last record is ignored), flushes the bitset and truncates the journal.
+
+class PlotRegistry {
+    struct Node {
+        int free, prefix, suffix, best;
+    };
+    struct JournalRecord {
+        uint64_t L, R;
+        uint32_t status, check;
+    };
+    static constexpr char MAGIC[8] = {'P', 'L', 'O', 'T', 'R', 'E', 'G', '1'};
+    static const int HEADER = 16;
+    static const int LEAF_WORDS = 8;
+    static const int LEAF_PLOTS = 64 * LEAF_WORDS;
+
+    int fd = -1, journalFd = -1;
+    char* base = nullptr;
+    size_t mappedBytes = 0;
+    uint64_t* words = nullptr;
+    long long n = 0;
+    int wordCount = 0, size = 1; // 'size' leaves of LEAF_WORDS words
+    vector<Node> t;
+    int syncEvery = 0, unsynced = 0;
+
+    static uint32_t checksum(const JournalRecord& r) {
+        uint64_t h = r.L * 0x9E3779B97F4A7C15ULL ^ (r.R + 0x632BE59BD9B4E019ULL) * 0xC2B2AE3D27D4EB4FULL ^ r.status;
+        return (uint32_t)(h ^ h >> 32) ^ 0x504C4F54;
+    }
+
+    // Aggregate of two adjacent blocks of lenA and lenB plots.
+    static Node combine(const Node& a, const Node& b, int lenA, int lenB) {
+        return {a.free + b.free, a.prefix == lenA ? lenA + b.prefix : a.prefix,
+                b.suffix == lenB ? lenB + a.suffix : b.suffix, max({a.best, b.best, a.suffix + b.prefix})};
+    }
+
+    static Node wordNode(uint64_t w) {
+        if (w == 0) return {64, 64, 64, 64};
+        if (w == ~0ULL) return {0, 0, 0, 0};
+        int best = 0;
+        for (uint64_t x = ~w; x; x &= x >> 1) best++; // Longest run of free bits
+        return {__builtin_popcountll(~w), __builtin_ctzll(w), __builtin_clzll(w), best};
+    }
+
+    // Aggregate of leaf 'leaf' (words past the end count as occupied).
+    Node leafNode(int leaf) const {
+        Node acc = {0, 0, 0, 0};
+        for (int j = 0; j < LEAF_WORDS; j++) {
+            int w = leaf * LEAF_WORDS + j;
+            Node x = wordNode(w < wordCount ? words[w] : ~0ULL);
+            acc = j == 0 ? x : combine(acc, x, 64 * j, 64);
+        }
+        return acc;
+    }
+
+    long long length(int i) const { return (long long)LEAF_PLOTS * (size >> (31 - __builtin_clz(i))); }
+
+    void pull(int i) { t[i] = combine(t[2 * i], t[2 * i + 1], length(i) / 2, length(i) / 2); }
+
+    // Sets plots [L, R] to 'status' in the mapped bitset.
+    void setBits(long long L, long long R, int status) {
+        long long wl = L >> 6, wr = R >> 6;
+        auto put = [&](long long w, uint64_t mask) { words[w] = status ? words[w] | mask : words[w] & ~mask; };
+        uint64_t lowMask = ~0ULL << (L & 63), highMask = ~0ULL >> (63 - (R & 63));
+        if (wl == wr) { put(wl, lowMask & highMask); return; }
+        put(wl, lowMask);
+        memset(words + wl + 1, status ? 0xFF : 0, (wr - wl - 1) * sizeof(uint64_t));
+        put(wr, highMask);
+    }
+
+    // Refreshes the leaves holding words wl .. wr and every ancestor above them.
+    void refresh(long long wl, long long wr) {
+        int ll = wl / LEAF_WORDS, lr = wr / LEAF_WORDS;
+        for (int leaf = ll; leaf <= lr; leaf++) t[size + leaf] = leafNode(leaf);
+        for (int lo = (ll + size) >> 1, hi = (lr + size) >> 1; lo >= 1; lo >>= 1, hi >>= 1)
+            for (int i = lo; i <= hi; i++) pull(i);
+    }
+
+    bool replayJournal() {
+        JournalRecord r;
+        long long replayed = 0;
+        while (::read(journalFd, &r, sizeof r) == (ssize_t)sizeof r) {
+            if (r.check != checksum(r) || r.L > r.R || (long long)r.R >= n || r.status > 1) break; // Torn tail
+            setBits(r.L, r.R, r.status);
+            replayed++;
+        }
+        if (replayed) cerr << "Recovered " << replayed << " journaled update(s).\n";
+        return true;
+    }
+
+public:
+    PlotRegistry() = default;
+    PlotRegistry(const PlotRegistry&) = delete;
+    PlotRegistry& operator=(const PlotRegistry&) = delete;
+    ~PlotRegistry() { close(); }
+
+    /**
+     * @brief Writes a new registry file for 'plots' plots with the given occupancy words.
+     * Bits past the last plot are stored as occupied.
+     */
+    static bool create(const string& path, long long plots, vector<uint64_t> bits) {
+        bits.resize((plots + 63) / 64, 0);
+        if (plots % 64) bits.back() |= ~0ULL << (plots % 64);
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out) return false;
+        uint64_t count = plots;
+        bool ok = fwrite(MAGIC, 1, 8, out) == 8 && fwrite(&count, 8, 1, out) == 1 &&
+                  fwrite(bits.data(), 8, bits.size(), out) == bits.size();
+        ok = fclose(out) == 0 && ok;
+        ::remove((path + ".journal").c_str());
+        return ok;
+    }
+
+    /**
+     * @brief One-time conversion of plots.csv (plot_id,status with 1-based IDs). Plots
+     * missing from the CSV are free.
+     */
+    static bool convertCSV(const string& csvPath, const string& path, long long& plots) {
+        FILE* in = fopen(csvPath.c_str(), "rb");
+        if (!in) return false;
+        vector<uint64_t> bits;
+        plots = 0;
+        vector<char> buf(1 << 20);
+        string carry;
+        bool header = true;
+        size_t got;
+        auto handle = [&](const char* line, size_t len) {
+            if (header) { header = false; return; }
+            const char* comma = (const char*)memchr(line, ',', len);
+            if (!comma) return;
+            long long id = atoll(string(line, comma - line).c_str());
+            int status = atoi(string(comma + 1, line + len - comma - 1).c_str());
+            if (id <= 0) return;
+            plots = max(plots, id);
+            if ((size_t)((id - 1) / 64) >= bits.size()) bits.resize((id - 1) / 64 + 1, 0);
+            if (status == 1) bits[(id - 1) / 64] |= 1ULL << ((id - 1) % 64);
+        };
+        while ((got = fread(buf.data(), 1, buf.size(), in)) > 0) {
+            size_t start = 0;
+            for (const char* nl; (nl = (const char*)memchr(buf.data() + start, '\n', got - start)); start = nl - buf.data() + 1) {
+                if (carry.empty()) {
+                    handle(buf.data() + start, nl - buf.data() - start);
+                } else {
+                    carry.append(buf.data() + start, nl - buf.data() - start);
+                    handle(carry.data(), carry.size());
+                    carry.clear();
+                }
+            }
+            carry.append(buf.data() + start, got - start);
+        }
+        if (!carry.empty()) handle(carry.data(), carry.size());
+        fclose(in);
+        return create(path, plots, move(bits));
+    }
+
+    /**
+     * @brief Maps the registry, replays and clears its journal, and rebuilds the tree.
+     */
+    bool open(const string& path) {
+        close();
+        fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0) return false;
+        struct stat st;
+        char magic[8];
+        uint64_t count = 0;
+        if (fstat(fd, &st) < 0 || st.st_size < HEADER || ::pread(fd, magic, 8, 0) != 8 ||
+            memcmp(magic, MAGIC, 8) != 0 || ::pread(fd, &count, 8, 8) != 8 ||
+            (uint64_t)st.st_size != HEADER + (count + 63) / 64 * 8) {
+            close();
+            return false;
+        }
+        mappedBytes = st.st_size;
+        void* p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) { base = nullptr; close(); return false; }
+        base = (char*)p;
+        words = (uint64_t*)(base + HEADER);
+        n = count;
+        wordCount = (n + 63) / 64;
+
+        journalFd = ::open((path + ".journal").c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+        if (journalFd < 0) { close(); return false; }
+        replayJournal();
+        checkpoint();
+
+        int leaves = (wordCount + LEAF_WORDS - 1) / LEAF_WORDS;
+        size = 1;
+        while (size < leaves) size <<= 1;
+        t.assign(2 * size, {0, 0, 0, 0});
+        for (int leaf = 0; leaf < leaves; leaf++) t[size + leaf] = leafNode(leaf);
+        for (int i = size - 1; i > 0; --i) pull(i);
+        return true;
+    }
+
+    /**
+     * @brief Flushes the bitset to disk and empties the journal.
+     */
+    void checkpoint() {
+        if (!base) return;
+        msync(base, mappedBytes, MS_SYNC);
+        if (ftruncate(journalFd, 0) == 0) fsync(journalFd);
+        unsynced = 0;
+    }
+
+    void close() {
+        if (base && journalFd >= 0) checkpoint();
+        abandon();
+    }
+
+    /**
+     * @brief Drops the mapping without a checkpoint, as a crash would (used by the benchmark).
+     */
+    void abandon() {
+        if (base) munmap(base, mappedBytes);
+        if (fd >= 0) ::close(fd);
+        if (journalFd >= 0) ::close(journalFd);
+        base = nullptr; words = nullptr; fd = journalFd = -1;
+        t.clear();
+    }
+
+    /**
+     * @brief fdatasync the journal every 'records' updates (0: leave it to the OS).
+     */
+    void setSyncEvery(int records) { syncEvery = records; }
+
+    /**
+     * @brief Journals, then applies, "plots [L, R] become 'status'".
+     * Time Complexity: O(log N + (R - L) / 64)
+     */
+    bool assign(long long L, long long R, int status) {
+        JournalRecord r{(uint64_t)L, (uint64_t)R, (uint32_t)status, 0};
+        r.check = checksum(r);
+        if (::write(journalFd, &r, sizeof r) != (ssize_t)sizeof r) return false;
+        if (syncEvery && ++unsynced >= syncEvery) { fdatasync(journalFd); unsynced = 0; }
+        setBits(L, R, status);
+        refresh(L >> 6, R >> 6);
+        return true;
+    }
+
+    /**
+     * @brief Number of free plots in [L, R].
+     */
+    long long countFree(long long L, long long R) const {
+        long long wl = L >> 6, wr = R >> 6;
+        uint64_t lowMask = ~0ULL << (L & 63), highMask = ~0ULL >> (63 - (R & 63));
+        if (wl == wr) return __builtin_popcountll(~words[wl] & lowMask & highMask);
+        long long sum = __builtin_popcountll(~words[wl] & lowMask) + __builtin_popcountll(~words[wr] & highMask);
+        // Whole words up to the next leaf boundary, whole leaves from the tree, then the rest.
+        long long w = wl + 1, end = wr;
+        for (; w < end && w % LEAF_WORDS; w++) sum += __builtin_popcountll(~words[w]);
+        for (; end > w && end % LEAF_WORDS; end--) sum += __builtin_popcountll(~words[end - 1]);
+        for (long long l = w / LEAF_WORDS + size, r = end / LEAF_WORDS + size; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) sum += t[l++].free;
+            if (r & 1) sum += t[--r].free;
+        }
+        return sum;
+    }
+
+    /**
+     * @brief First plot of the leftmost run of k contiguous free plots, or -1.
+     */
+    long long findFreeRun(long long k) const {
+        if (k <= 0 || t[1].best < k) return -1;
+        int i = 1;
+        while (i < size) {
+            const Node &a = t[2 * i], &b = t[2 * i + 1];
+            if (a.best >= k) i = 2 * i;
+            else if (a.suffix + b.prefix >= k) return (long long)(2 * i + 1) * (length(i) / 2) - (long long)LEAF_PLOTS * size - a.suffix;
+            else i = 2 * i + 1;
+        }
+        long long first = (long long)(i - size) * LEAF_PLOTS;
+        for (long long p = first, run = 0; p < first + LEAF_PLOTS && p < n; p++) {
+            run = status(p) ? 0 : run + 1;
+            if (run == k) return p - k + 1;
+        }
+        return -1;
+    }
+
+    int status(long long idx) const { return words[idx >> 6] >> (idx & 63) & 1; }
+    long long plotCount() const { return n; }
+    long long totalFree() const { return t[1].free; }
+    const uint64_t* bits() const { return words; }
+    int bitWords() const { return wordCount; }
+};
+
+// --- Benchmark: range allocation vs the per-plot update loop ---
+
+double msSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * @brief Applies the same random block allocations/releases (up to 10k plots each) with
+ * the original recursive tree, one update() per plot, and with PlotTree::assign, then
+ * cross-checks counts and the free-run search against a direct scan.
+ */
+int runBenchmark(int plotCount, int ops) {
+    mt19937 rng(21);
+    uniform_int_distribution<int> start(0, plotCount - 1), len(1, 10000), coin(0, 2);
+    struct Op { int L, R, status; };
+    vector<Op> blocks(ops);
+    for (auto& op : blocks) {
+        op.L = start(rng);
+        op.R = min(plotCount - 1, op.L + len(rng) - 1);
+        op.status = coin(rng) != 0; // Two allocations per release on average
+    }
+    cout << "Plots: " << plotCount << ", block operations: " << ops << "\n\n";
+
+    // Original structure: global arrays, recursive build/update/query.
+    N = plotCount;
+    plots.assign(N, 0);
+    tree.assign(4 * N + 1, 0);
+    auto t0 = chrono::steady_clock::now();
+    build(1, 0, N - 1);
+    double oldBuild = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    long long plotUpdates = 0;
+    for (auto& op : blocks)
+        for (int i = op.L; i <= op.R; i++, plotUpdates++) update(1, 0, N - 1, i, op.status);
+    double oldOps = msSince(t0);
+
+    PlotTree land;
+    vector<int> allFree(plotCount, 0);
+    t0 = chrono::steady_clock::now();
+    land.build(allFree);
+    double newBuild = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    for (auto& op : blocks) land.assign(op.L, op.R, op.status);
+    double newOps = msSince(t0);
+
+    printf("%-22s %12s %16s %14s\n", "", "build (ms)", "operations (ms)", "us/operation");
+    printf("%-22s %12.1f %16.1f %14.2f\n", "per-plot update loop", oldBuild, oldOps, oldOps * 1000 / ops);
+    printf("%-22s %12.1f %16.1f %14.2f\n", "PlotTree range assign", newBuild, newOps, newOps * 1000 / ops);
+    printf("(%lld single-plot updates replaced by %d range assigns)\n", plotUpdates, ops);
+    printf("Tree memory: %.1f MB (4N sums) vs %.1f MB (N-1 nodes of 4 aggregates + tags, N status bytes)\n\n",
+           tree.size() * sizeof(int) / 1e6, land.memoryBytes() / 1e6);
+
+    int mismatches = 0;
+    for (int q = 0; q < 1000; q++) {
+        int L = start(rng), R = min(plotCount - 1, L + len(rng) * 10);
+        if (land.countFree(L, R) != query(1, 0, N - 1, L, R)) mismatches++;
+    }
+
+    // First run of k free plots, against a left-to-right scan of the plot array.
+    double scanMs = 0, treeMs = 0;
+    for (int k : {1, 10, 100, 1000, 5000, 20000}) {
+        t0 = chrono::steady_clock::now();
+        int expected = -1;
+        for (int i = 0, run = 0; i < N; i++) {
+            run = plots[i] == 0 ? run + 1 : 0;
+            if (run == k) { expected = i - k + 1; break; }
+        }
+        scanMs += msSince(t0);
+        t0 = chrono::steady_clock::now();
+        int found = land.findFreeRun(k);
+        treeMs += msSince(t0);
+        if (found != expected) mismatches++;
+    }
+    printf("First free run of k plots (6 queries): scan %.3f ms, tree %.3f ms\n", scanMs, treeMs);
+    printf("%d mismatch(es) against the original tree and the scan\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Registry startup, update throughput and journal recovery on a large plot file.
+ */
+int runRegistryBenchmark(long long plotCount, int updates) {
+    const string path = "/tmp/plots_bench.bin";
+    mt19937_64 rng(5);
+    vector<uint64_t> bits((plotCount + 63) / 64);
+    // Clumped occupancy: alternating occupied and free stretches of random length.
+    for (long long i = 0, status = 1; i < plotCount; status ^= 1) {
+        long long len = 1 + rng() % (status ? 3000 : 800);
+        for (long long j = i; j < min(plotCount, i + len); j++)
+            if (status) bits[j >> 6] |= 1ULL << (j & 63);
+        i += len;
+    }
+    if (!PlotRegistry::create(path, plotCount, bits)) { cerr << "Could not write " << path << "\n"; return 1; }
+    printf("Registry: %lld plots, %.1f MB bitset file\n\n", plotCount, bits.size() * 8 / 1e6);
+
+    PlotRegistry reg;
+    auto t0 = chrono::steady_clock::now();
+    if (!reg.open(path)) { cerr << "Could not open " << path << "\n"; return 1; }
+    printf("Startup (map + tree rebuild): %.1f ms, %lld free plots\n", msSince(t0), reg.totalFree());
+
+    uniform_int_distribution<long long> start(0, plotCount - 1), len(1, 1000);
+    struct Op { long long L, R; int status; };
+    vector<Op> ops(updates);
+    for (auto& op : ops) {
+        op.L = start(rng);
+        op.R = min(plotCount - 1, op.L + len(rng) - 1);
+        op.status = rng() % 2;
+    }
+
+    printf("\n%-34s %14s\n", "journaled block updates", "updates/s");
+    for (int syncEvery : {0, 1000, 100}) {
+        reg.setSyncEvery(syncEvery);
+        t0 = chrono::steady_clock::now();
+        for (auto& op : ops) reg.assign(op.L, op.R, op.status);
+        double ms = msSince(t0);
+        string label = syncEvery ? "fdatasync every " + to_string(syncEvery) : "no fdatasync (OS flushes)";
+        printf("%-34s %14.0f\n", label.c_str(), updates / (ms / 1000));
+    }
+
+    // Crash recovery: snapshot the bits, apply journaled updates, "crash" without a
+    // checkpoint, put the stale bits back and check that reopening replays the journal.
+    reg.checkpoint();
+    vector<uint64_t> before(reg.bits(), reg.bits() + reg.bitWords());
+    for (auto& op : ops) reg.assign(op.L, op.R, op.status ^ 1);
+    vector<uint64_t> expected(reg.bits(), reg.bits() + reg.bitWords());
+    reg.abandon();
+    PlotRegistry::create(path + ".stale", plotCount, before);
+    rename((path + ".stale").c_str(), path.c_str()); // Keeps the journal next to 'path'
+    t0 = chrono::steady_clock::now();
+    if (!reg.open(path)) { cerr << "Could not reopen " << path << "\n"; return 1; }
+    printf("\nRestart with %d journaled updates to replay: %.1f ms\n", updates, msSince(t0));
+
+    int mismatches = !equal(expected.begin(), expected.end(), reg.bits());
+    for (int q = 0; q < 1000; q++) {
+        long long L = start(rng), R = min(plotCount - 1, L + (long long)(rng() % 5000000));
+        long long naive = 0;
+        for (long long i = L; i <= R; i++) naive += !reg.status(i);
+        if (reg.countFree(L, R) != naive) mismatches++;
+    }
+    for (long long k : {1, 64, 100, 700}) {
+        long long expectedStart = -1;
+        for (long long i = 0, run = 0; i < plotCount; i++) {
+            run = reg.status(i) ? 0 : run + 1;
+            if (run == k) { expectedStart = i - k + 1; break; }
+        }
+        if (reg.findFreeRun(k) != expectedStart) mismatches++;
+    }
+    printf("%d mismatch(es) after recovery (bits, range counts, free-run search)\n", mismatches);
+    reg.close();
+    remove(path.c_str());
+    remove((path + ".journal").c_str());
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Menu over a persistent registry file (./code registry <plots.bin>).
+ */
+int runRegistry(const string& path) {
+    PlotRegistry reg;
+    if (!reg.open(path)) {
+        cerr << "Could not open registry " << path << " (create it with: convert <plots.csv> " << path << ")\n";
+        return 1;
+    }
+    reg.setSyncEvery(1); // Interactive edits are few: make each one durable before reporting it
+    long long plotsN = reg.plotCount();
+    int choice;
+    do {
+        cout << "\n--- Registry " << path << ": " << plotsN << " plots, " << reg.totalFree() << " free ---\n";
+        cout << "1. Allocate Block [L, R]\n";
+        cout << "2. Release Block [L, R]\n";
+        cout << "3. Query Free Plots in Range\n";
+        cout << "4. Exit\n";
+        cout << "5. Find and Allocate First Run of k Free Plots\n";
+        cout << "Enter choice: ";
+        if (!(cin >> choice)) break;
+
+        if (choice >= 1 && choice <= 3) {
+            long long L, R;
+            cout << "Enter start index (L): ";
+            cin >> L;
+            cout << "Enter end index (R): ";
+            if (!(cin >> R) || L < 0 || R >= plotsN || L > R) {
+                cout << "Invalid range.\n";
+                continue;
+            }
+            if (choice == 3) {
+                cout << "\nQUERY RESULT: In the range [" << L << ", " << R << "], there are "
+                     << reg.countFree(L, R) << " FREE plots available.\n";
+            } else if (reg.assign(L, R, choice == 1)) {
+                cout << "SUCCESS: Plots " << L << " to " << R << " are now " << (choice == 1 ? "OCCUPIED" : "FREE") << ".\n";
+            } else {
+                cout << "Could not write the journal; nothing was changed.\n";
+            }
+        } else if (choice == 5) {
+            long long k;
+            cout << "Enter number of contiguous plots needed (k): ";
+            if (!(cin >> k) || k <= 0) {
+                cout << "Invalid size.\n";
+                continue;
+            }
+            long long start = reg.findFreeRun(k);
+            if (start == -1) cout << "No run of " << k << " contiguous free plots is available.\n";
+            else if (reg.assign(start, start + k - 1, 1)) cout << "SUCCESS: Allocated plots " << start << " to " << start + k - 1 << ".\n";
+            else cout << "Could not write the journal; nothing was changed.\n";
+        } else if (choice == 4) {
+            cout << "Exiting City Land Management System.\n";
+        } else {
+            cout << "Invalid choice. Please try again.\n";
+        }
+    } while (choice != 4);
+    return 0;
+}
+
+// --- 2D Free-Plot Index ---
+// Parcels live on a map grid: plot id p sits at row p / width, column p % width (the same
+// numbering as the registry and plots.csv). A 2D Fenwick tree over the grid counts free
+// plots, so allocating or releasing one plot and counting the free plots in any rectangle
+// of blocks both take O(log R * log C).
+// Where the Fenwick cells sit in memory is a policy: row-major, or Z-order (Morton) so
+// cells that are close in both row and column share cache lines and pages.
+
+struct RowMajorLayout {
+    int stride = 0;
+    size_t cells(int rows, int cols) { stride = cols; return (size_t)rows * cols; }
+    size_t index(int r, int c) const { return (size_t)r * stride + c; }
+};
+
+// Morton order inside square tiles whose side is the shorter grid side rounded up to a power
+// of two; tiles follow each other along the longer side, so a narrow map is not padded out
+// to a huge square. A tile side above 65536 is rejected (spread() keeps 16 bits per axis).
+struct ZOrderLayout {
+    vector<size_t> rowBits, colBits; // Tile offset + Morton bits of each row/column, precomputed
+
+    // Spreads the low 16 bits of x to the even bit positions.
+    static uint32_t spread(uint32_t x) {
+        x &= 0xFFFF;
+        x = (x | (x << 8)) & 0x00FF00FF;
+        x = (x | (x << 4)) & 0x0F0F0F0F;
+        x = (x | (x << 2)) & 0x33333333;
+        x = (x | (x << 1)) & 0x55555555;
+        return x;
+    }
+    size_t cells(int rows, int cols) {
+        size_t tile = 1;
+        while (tile < (size_t)min(rows, cols)) tile <<= 1;
+        if (tile > 65536) throw length_error("Z-order layout supports at most 65536 cells on the shorter side");
+        size_t tileCells = tile * tile;
+        bool tall = rows > cols; // Tiles are stacked along the longer side
+        rowBits.resize(rows);
+        colBits.resize(cols);
+        for (int r = 0; r < rows; r++) rowBits[r] = ((size_t)spread(r & (tile - 1)) << 1) + (tall ? r / tile * tileCells : 0);
+        for (int c = 0; c < cols; c++) colBits[c] = spread(c & (tile - 1)) + (tall ? 0 : c / tile * tileCells);
+        return ((size_t)max(rows, cols) + tile - 1) / tile * tileCells;
+    }
+    size_t index(int r, int c) const { return rowBits[r] + colBits[c]; }
+};
+
+/**
+ * @brief Free-plot counts over a rows x cols parcel grid (status 0: free, 1: occupied).
+ */
+template <class Layout>
+class FreePlotGrid {
+    int rows = 0, cols = 0;
+    Layout layout;
+    vector<int> fen;             // Fenwick cells (1-based row/column), placed by Layout
+    vector<unsigned char> occ;   // Row-major plot status
+
+    int& at(int r, int c) { return fen[layout.index(r, c)]; }
+
+    // Free plots in rows [0, r) x columns [0, c).
+    int prefix(int r, int c) const {
+        int sum = 0;
+        for (int i = r; i > 0; i -= i & -i)
+            for (int j = c; j > 0; j -= j & -j) sum += fen[layout.index(i, j)];
+        return sum;
+    }
+
+    void add(int r, int c, int delta) {
+        for (int i = r + 1; i <= rows; i += i & -i)
+            for (int j = c + 1; j <= cols; j += j & -j) at(i, j) += delta;
+    }
+
+public:
+    /**
+     * @brief Builds the index in O(R * C): every cell starts as its own plot and is pushed
+     * into its Fenwick parent, first along rows, then along columns.
+     */
+    void build(int gridRows, int gridCols, const vector<unsigned char>& status) {
+        rows = gridRows; cols = gridCols;
+        fen.assign(layout.cells(rows + 1, cols + 1), 0);
+        occ = status;
+        occ.resize((size_t)rows * cols, 1); // Cells past the last plot are not real parcels
+        for (int r = 1; r <= rows; r++)
+            for (int c = 1; c <= cols; c++) at(r, c) = occ[(size_t)(r - 1) * cols + c - 1] == 0;
+        for (int r = 1; r <= rows; r++)
+            for (int c = 1; c <= cols; c++) {
+                int parent = c + (c & -c);
+                if (parent <= cols) at(r, parent) += at(r, c);
+            }
+        for (int r = 1; r <= rows; r++) {
+            int parent = r + (r & -r);
+            if (parent > rows) continue;
+            for (int c = 1; c <= cols; c++) at(parent, c) += at(r, c);
+        }
+    }
+
+    /**
+     * @brief Point Update: sets the plot at (r, c) to occupied (1) or free (0).
+     */
+    void set(int r, int c, int status) {
+        unsigned char& cur = occ[(size_t)r * cols + c];
+        if (cur == status) return;
+        cur = status;
+        add(r, c, status ? -1 : 1);
+    }
+
+    /**
+     * @brief Free plots in the rectangle rows [r1, r2] x columns [c1, c2] (inclusive).
+     */
+    int countFree(int r1, int c1, int r2, int c2) const {
+        return prefix(r2 + 1, c2 + 1) - prefix(r1, c2 + 1) - prefix(r2 + 1, c1) + prefix(r1, c1);
+    }
+
+    int status(int r, int c) const { return occ[(size_t)r * cols + c]; }
+    int rowCount() const { return rows; }
+    int colCount() const { return cols; }
+    size_t memoryBytes() const { return fen.size() * sizeof(int) + occ.size(); }
+};
+
+/**
+ * @brief Mixed point updates and rectangle counts on ~10^7 parcels, row-major vs Z-order.
+ */
+int runGridBenchmark(long long parcels, int ops) {
+    int cols = (int)ceil(sqrt((double)parcels));
+    int rows = (int)((parcels + cols - 1) / cols);
+    mt19937 rng(17);
+    vector<unsigned char> status(parcels);
+    for (auto& s : status) s = rng() % 10 < 6; // 60% occupied
+    printf("Parcel grid: %d x %d (%lld parcels), %d operations per workload\n\n", rows, cols, parcels, ops);
+
+    FreePlotGrid<RowMajorLayout> rowMajor;
+    FreePlotGrid<ZOrderLayout> zOrder;
+    auto t0 = chrono::steady_clock::now();
+    rowMajor.build(rows, cols, status);
+    double rowBuild = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    zOrder.build(rows, cols, status);
+    double zBuild = msSince(t0);
+    printf("Build: row-major %.0f ms (%.0f MB), Z-order %.0f ms (%.0f MB)\n\n", rowBuild, rowMajor.memoryBytes() / 1e6,
+           zBuild, zOrder.memoryBytes() / 1e6);
+
+    // Operations: point updates anywhere; rectangles are neighbourhood-sized (up to 64
+    // blocks a side) or district-sized (up to a quarter of the map a side).
+    struct Op { int kind, r1, c1, r2, c2; };
+    auto makeOps = [&](int updatePercent) {
+        vector<Op> list(ops);
+        for (auto& op : list) {
+            op.kind = (int)(rng() % 100) < updatePercent ? (int)(rng() % 2) : 2;
+            op.r1 = rng() % rows; op.c1 = rng() % cols;
+            int span = rng() % 4 == 0 ? max(1, rows / 4) : 64;
+            op.r2 = min(rows - 1, op.r1 + (int)(rng() % span));
+            op.c2 = min(cols - 1, op.c1 + (int)(rng() % span));
+        }
+        return list;
+    };
+
+    int mismatches = 0;
+    printf("%-22s %18s %18s\n", "workload", "row-major ns/op", "Z-order ns/op");
+    for (int updatePercent : {90, 50, 10}) {
+        vector<Op> list = makeOps(updatePercent);
+        long long checkRow = 0, checkZ = 0;
+        t0 = chrono::steady_clock::now();
+        for (auto& op : list) {
+            if (op.kind < 2) rowMajor.set(op.r1, op.c1, op.kind);
+            else checkRow += rowMajor.countFree(op.r1, op.c1, op.r2, op.c2);
+        }
+        double rowNs = msSince(t0) * 1e6 / ops;
+        t0 = chrono::steady_clock::now();
+        for (auto& op : list) {
+            if (op.kind < 2) zOrder.set(op.r1, op.c1, op.kind);
+            else checkZ += zOrder.countFree(op.r1, op.c1, op.r2, op.c2);
+        }
+        double zNs = msSince(t0) * 1e6 / ops;
+        if (checkRow != checkZ) mismatches++;
+        string label = to_string(updatePercent) + "% updates";
+        printf("%-22s %18.0f %18.0f\n", label.c_str(), rowNs, zNs);
+    }
+
+    // Spot-check rectangles against a direct count.
+    for (int q = 0; q < 200; q++) {
+        int r1 = rng() % rows, c1 = rng() % cols;
+        int r2 = min(rows - 1, r1 + (int)(rng() % 200)), c2 = min(cols - 1, c1 + (int)(rng() % 200));
+        int naive = 0;
+        for (int r = r1; r <= r2; r++)
+            for (int c = c1; c <= c2; c++) naive += rowMajor.status(r, c) == 0;
+        if (naive != rowMajor.countFree(r1, c1, r2, c2) || naive != zOrder.countFree(r1, c1, r2, c2)) mismatches++;
+    }
+    // A narrow strip map: Z-order tiles along the long side instead of padding to a square.
+    {
+        int stripRows = 100000, stripCols = 3;
+        vector<unsigned char> strip((size_t)stripRows * stripCols);
+        for (auto& s : strip) s = rng() % 2;
+        FreePlotGrid<RowMajorLayout> rowStrip;
+        FreePlotGrid<ZOrderLayout> zStrip;
+        rowStrip.build(stripRows, stripCols, strip);
+        zStrip.build(stripRows, stripCols, strip);
+        for (int q = 0; q < 1000; q++) {
+            int r1 = rng() % stripRows, c1 = rng() % stripCols;
+            int r2 = min(stripRows - 1, r1 + (int)(rng() % 5000)), c2 = c1 + (int)(rng() % (stripCols - c1));
+            if (q % 3 == 0) { rowStrip.set(r1, c1, q % 2); zStrip.set(r1, c1, q % 2); }
+            if (rowStrip.countFree(r1, c1, r2, c2) != zStrip.countFree(r1, c1, r2, c2)) mismatches++;
+        }
+        printf("Strip map %d x %d: Z-order %.1f MB vs row-major %.1f MB\n", stripRows, stripCols,
+               zStrip.memoryBytes() / 1e6, rowStrip.memoryBytes() / 1e6);
+    }
+    printf("\n%d mismatch(es) between layouts and against direct counts\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Menu over a registry file viewed as a map grid 'width' plots wide
+ * (./code grid <plots.bin> <width>). Point changes are written through to the registry.
+ */
+int runGrid(const string& path, int width) {
+    PlotRegistry reg;
+    if (width <= 0 || !reg.open(path)) {
+        cerr << "Could not open registry " << path << "\n";
+        return 1;
+    }
+    reg.setSyncEvery(1); // As in runRegistry: each edit is durable before it is reported
+    long long plotsN = reg.plotCount();
+    int rows = (int)((plotsN + width - 1) / width);
+    vector<unsigned char> status(plotsN);
+    for (long long i = 0; i < plotsN; i++) status[i] = reg.status(i);
+    FreePlotGrid<RowMajorLayout> grid; // Measured faster than Z-order by grid-bench, and never padded
+    grid.build(rows, width, status);
+
+    int choice;
+    do {
+        cout << "\n--- Map grid: " << rows << " rows x " << width << " columns (" << plotsN << " plots) ---\n";
+        cout << "1. Allocate Plot (by plot index)\n";
+        cout << "2. Release Plot (by plot index)\n";
+        cout << "3. Count Free Plots in Rectangle\n";
+        cout << "4. Exit\n";
+        cout << "Enter choice: ";
+        if (!(cin >> choice)) break;
+
+        if (choice == 1 || choice == 2) {
+            long long id;
+            cout << "Enter plot index (0 to " << plotsN - 1 << "): ";
+            if (!(cin >> id) || id < 0 || id >= plotsN) {
+                cout << "Invalid index.\n";
+                continue;
+            }
+            int new_status = (choice == 1) ? 1 : 0;
+            if (!reg.assign(id, id, new_status)) {
+                cout << "Could not write the journal; nothing was changed.\n";
+                continue;
+            }
+            grid.set(id / width, id % width, new_status);
+            cout << "SUCCESS: Plot " << id << " at (row " << id / width << ", column " << id % width << ") is now "
+                 << (new_status == 1 ? "OCCUPIED" : "FREE") << ".\n";
+        } else if (choice == 3) {
+            int r1, c1, r2, c2;
+            cout << "Enter top-left corner (row column): ";
+            cin >> r1 >> c1;
+            cout << "Enter bottom-right corner (row column): ";
+            if (!(cin >> r2 >> c2) || r1 < 0 || c1 < 0 || r2 >= rows || c2 >= width || r1 > r2 || c1 > c2) {
+                cout << "Invalid rectangle.\n";
+                continue;
+            }
+            cout << "\nQUERY RESULT: Rows " << r1 << "-" << r2 << ", columns " << c1 << "-" << c2 << " contain "
+                 << grid.countFree(r1, c1, r2, c2) << " FREE plots.\n";
+        } else if (choice == 4) {
+            cout << "Exiting City Land Management System.\n";
+        } else {
+            cout << "Invalid choice. Please try again.\n";
+        }
+    } while (choice != 4);
+    return 0;
+}
+
 // --- Main Program and User Interface ---
 
-void printPlotStatus() {
+void printPlotStatus(PlotTree& land) {
     cout << "\n--- Current City Plot Status ---\n";
     cout << "Index:\t";
     for (int i = 0; i < N; ++i) {
         cout << i << "\t";
     }
     cout << "\nStatus:\t";
-    for (int status : plots) {
-        cout << (status == 1 ? "OCC" : "FREE") << "\t";
+    for (int i = 0; i < N; ++i) {
+        cout << (land.status(i) == 1 ? "OCC" : "FREE") << "\t";
     }
     cout << "\n--------------------------------\n";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 1 << 20, argc > 3 ? atoi(argv[3]) : 2000);
+    }
+    if (argc > 1 && string(argv[1]) == "registry-bench") {
+        return runRegistryBenchmark(argc > 2 ? atoll(argv[2]) : 100000000, argc > 3 ? atoi(argv[3]) : 100000);
+    }
+    if (argc > 3 && string(argv[1]) == "convert") {
+        long long plotsN;
+        if (!PlotRegistry::convertCSV(argv[2], argv[3], plotsN)) {
+            cerr << "Could not convert " << argv[2] << " to " << argv[3] << "\n";
+            return 1;
+        }
+        cout << "Wrote " << plotsN << " plots to " << argv[3] << "\n";
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "grid-bench") {
+        return runGridBenchmark(argc > 2 ? atoll(argv[2]) : 10000000, argc > 3 ? atoi(argv[3]) : 2000000);
+    }
+    if (argc > 3 && string(argv[1]) == "grid") {
+        return runGrid(argv[2], atoi(argv[3]));
+    }
+    if (argc > 2 && string(argv[1]) == "registry") {
+        return runRegistry(argv[2]);
+    }
+
     cout << "--- My City Map Land Management System (Segment Tree) ---\n";
     
     // 1. Input Total Plots
@@ -136,9 +1131,7 @@ int main() {
         return 1;
     }
 
-    // Resize data structures (Segment Tree size is roughly 4*N)
     plots.resize(N);
-    tree.resize(4 * N + 1); 
 
     // 2. Input Initial Plot Status
     cout << "Enter initial status for each plot (0 for Free, 1 for Occupied):\n";
@@ -152,18 +1145,22 @@ int main() {
         plots[i] = status;
     }
 
-    // 3. Build the Segment Tree
-    build(1, 0, N - 1); // Start building from root (node 1) covering the whole range [0, N-1]
+    // 3. Build the Segment Tree (iterative layout with range assign, see PlotTree)
+    PlotTree land;
+    land.build(plots);
 
     // 4. Main Loop for Dynamic Operations
     int choice;
     do {
-        printPlotStatus();
+        printPlotStatus(land);
         cout << "\n--- Select Operation ---\n";
         cout << "1. Allocate Land (Update Status to Occupied)\n";
         cout << "2. Release Land (Update Status to Free)\n";
         cout << "3. Query Free Plots in Range\n";
         cout << "4. Exit\n";
+        cout << "5. Allocate Block [L, R]\n";
+        cout << "6. Release Block [L, R]\n";
+        cout << "7. Find and Allocate First Run of k Free Plots\n";
         cout << "Enter choice: ";
         cin >> choice;
 
@@ -178,10 +1175,10 @@ int main() {
             
             int new_status = (choice == 1) ? 1 : 0; // 1: Occupied, 0: Free
             
-            if (plots[plot_idx] == new_status) {
+            if (land.status(plot_idx) == new_status) {
                 cout << "Plot " << plot_idx << " is already " << (new_status == 1 ? "Occupied" : "Free") << ".\n";
             } else {
-                update(1, 0, N - 1, plot_idx, new_status);
+                land.assign(plot_idx, plot_idx, new_status);
                 cout << "SUCCESS: Plot " << plot_idx << " status updated to " << (new_status == 1 ? "OCCUPIED" : "FREE") << ".\n";
             }
             
@@ -197,11 +1194,40 @@ int main() {
             }
             
             // Perform the O(log N) query
-            int free_count = query(1, 0, N - 1, L, R);
+            int free_count = land.countFree(L, R);
             
             cout << "\nQUERY RESULT: In the range [" << L << ", " << R << "], there are " 
                  << free_count << " FREE plots available.\n";
                  
+        } else if (choice == 5 || choice == 6) {
+            // Range Assign Operation: one O(log N) update for the whole block
+            int L, R;
+            cout << "Enter block start index (L): ";
+            cin >> L;
+            cout << "Enter block end index (R): ";
+            if (!(cin >> R) || L < 0 || R >= N || L > R) {
+                cout << "Invalid range.\n";
+                continue;
+            }
+            int new_status = (choice == 5) ? 1 : 0;
+            land.assign(L, R, new_status);
+            cout << "SUCCESS: Plots " << L << " to " << R << " are now " << (new_status == 1 ? "OCCUPIED" : "FREE") << ".\n";
+
+        } else if (choice == 7) {
+            int k;
+            cout << "Enter number of contiguous plots needed (k): ";
+            if (!(cin >> k) || k <= 0) {
+                cout << "Invalid size.\n";
+                continue;
+            }
+            int start = land.findFreeRun(k);
+            if (start == -1) {
+                cout << "No run of " << k << " contiguous free plots is available.\n";
+            } else {
+                land.assign(start, start + k - 1, 1);
+                cout << "SUCCESS: Allocated plots " << start << " to " << start + k - 1 << ".\n";
+            }
+
         } else if (choice == 4) {
             cout << "Exiting City Land Management System.\n";
         } else {
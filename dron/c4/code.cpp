@@ -7,6 +7,16 @@
 
     The system is fully scalable. More rows, columns, or real-world crime 
     records can be added easily without modifying the algorithm.
+
+    Usage:
+        ./code [crime.csv]                     interactive ranking on the demo grid
+        ./code bench [threshold k size...]     union-find labeling vs DFS on large rasters
+        ./code sweep [crime.csv]               interactive ranking for many thresholds
+        ./code sweep-bench [size...]           component tree vs re-clustering per threshold
+        ./code stream <rows> <cols> <window_s> <threshold> [k] < feed
+                                               sliding-window hotspots over an incident feed
+        ./code stream-bench [size events query_every]   replay a synthetic 48h feed
+        ./code csv-bench <out.csv> [rows cols]  mapped CSV loader vs getline/stoi, in GB/s
 */
 
 #include <iostream>
@@ -14,12 +24,152 @@
 #include <string>
 #include <sstream>
 #include <queue>
+#include <deque>
 #include <algorithm>
 #include <map>
 #include <tuple>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <cstdio>
+#include <climits>
+#include <pthread.h>
+#include <fstream>
+#include <charconv>
+#include <string_view>
+#include <unordered_map>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace std;
 
+// --- CSV INGESTION ---
+// crime.csv-style files are read straight from a read-only mapping: each row is handed over
+// as string_views into the mapping, numbers are parsed with from_chars, and nothing is
+// copied unless the caller keeps it (place names are interned once per distinct name).
+
+/**
+ * @brief Interns place names: each distinct name is stored once and referred to by a small ID.
+ */
+class PlaceNames {
+    deque<string> names;                    // deque: stored strings never move
+    unordered_map<string_view, int> ids;    // Keys view into 'names'
+    int last = -1;
+
+public:
+    int intern(string_view name) {
+        // Neighbouring rows usually name the same place; check the last hit before hashing.
+        if (last >= 0 && names[last] == name) return last;
+        auto it = ids.find(name);
+        if (it != ids.end()) return last = it->second;
+        names.emplace_back(name);
+        last = (int)names.size() - 1;
+        ids.emplace(names.back(), last);
+        return last;
+    }
+    const string& name(int id) const {
+        static const string unknown;
+        return id >= 0 && id < (int)names.size() ? names[id] : unknown;
+    }
+    size_t size() const { return names.size(); }
+};
+
+/**
+ * @brief Parses a whole field as an integer; false if it is not one.
+ */
+bool parse_int(string_view field, int& value) {
+    while (!field.empty() && field.front() == ' ') field.remove_prefix(1);
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\r')) field.remove_suffix(1);
+    auto result = from_chars(field.data(), field.data() + field.size(), value);
+    return result.ec == errc() && result.ptr == field.data() + field.size();
+}
+
+/**
+ * @brief A memory-mapped CSV file. Fields are split on commas; a field wrapped in double quotes
+ * has the quotes removed (doubled quotes inside it are left as they are).
+ */
+class MappedCsv {
+    const char* data = nullptr;
+    size_t length = 0;
+
+public:
+    static const int MAX_FIELDS = 16;
+
+    MappedCsv() = default;
+    MappedCsv(const MappedCsv&) = delete;
+    MappedCsv& operator=(const MappedCsv&) = delete;
+    ~MappedCsv() { close(); }
+
+    bool open(const string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = (size_t)st.st_size;
+        if (length > 0) {
+            void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            madvise(map, length, MADV_SEQUENTIAL);
+            data = (const char*)map;
+        }
+        ::close(fd); // The mapping stays valid without the descriptor
+        return true;
+    }
+
+    void close() {
+        if (data) munmap((void*)data, length);
+        data = nullptr;
+        length = 0;
+    }
+
+    size_t size() const { return length; }
+
+    /**
+     * @brief Calls on_row(fields, count) for every non-empty line, header included; returns
+     * the number of lines seen. Fields past MAX_FIELDS are folded into the last one.
+     */
+    template <class OnRow>
+    size_t for_each_row(OnRow on_row) const {
+        string_view fields[MAX_FIELDS];
+        size_t lines = 0;
+        const char* p = data;
+        const char* end = data + length;
+        while (p < end) {
+            const char* eol = (const char*)memchr(p, '\n', end - p);
+            if (!eol) eol = end;
+            int count = 0;
+            const char* field = p;
+            while (true) {
+                const char* comma = count + 1 < MAX_FIELDS ? (const char*)memchr(field, ',', eol - field) : nullptr;
+                const char* stop = comma ? comma : eol;
+                string_view view(field, stop - field);
+                if (view.size() >= 2 && view.front() == '"' && view.back() == '"') view = view.substr(1, view.size() - 2);
+                fields[count++] = view;
+                if (!comma) break;
+                field = comma + 1;
+            }
+            if (eol > p && !(eol - p == 1 && *p == '\r')) {
+                on_row(fields, count);
+                lines++;
+            }
+            p = eol + 1;
+        }
+        return lines;
+    }
+};
+
 // --- GLOBAL CONFIGURATION ---
 const int ROWS = 15;
 const int COLS = 15;
@@ -30,8 +180,9 @@ const int NUM_DIRECTIONS = 4;
 // Global data structures
 int crime_grid[ROWS][COLS] = {0};
 bool visited[ROWS][COLS] = {false};
-// Map to store the place name for reporting purposes: Key = (row*COLS + col), Value = place_name
-map<int, string> place_name_map; 
+// Place names for reporting purposes: each cell holds an ID into the interned name table
+PlaceNames place_names;
+int place_id[ROWS][COLS]; // -1 until a record names the cell (set in main)
 
 
 /**
@@ -41,6 +192,13 @@ int get_key(int r, int c) {
     return r * COLS + c;
 }
 
+/**
+ * @brief Place name of a 0-based demo-grid cell (empty if the data did not name it).
+ */
+const string& place_name_at(int r, int c) {
+    return place_names.name(place_id[r][c]);
+}
+
 /**
  * @brief Depth First Search to find a connected high-crime cluster.
  * * @param r Current row index (0-based).
@@ -111,13 +269,923 @@ void parse_data(const string& raw_data) {
 
         if (r_0based >= 0 && r_0based < ROWS && c_0based >= 0 && c_0based < COLS) {
             crime_grid[r_0based][c_0based] = score;
-            place_name_map[get_key(r_0based, c_0based)] = current_place_name;
+            place_id[r_0based][c_0based] = place_names.intern(current_place_name);
+        }
+    }
+}
+
+
+/**
+ * @brief Loads a crime.csv file into the demo grid, replacing the embedded dataset. Records
+ * outside the ROWS x COLS grid are ignored, as in parse_data.
+ */
+bool load_crime_csv(const string& path) {
+    MappedCsv csv;
+    if (!csv.open(path)) return false;
+    csv.for_each_row([&](const string_view* f, int count) {
+        int r, c, score;
+        if (count < 4 || !parse_int(f[0], r) || !parse_int(f[1], c) || !parse_int(f[3], score)) return;
+        if (r >= 1 && r <= ROWS && c >= 1 && c <= COLS) {
+            crime_grid[r - 1][c - 1] = score;
+            place_id[r - 1][c - 1] = place_names.intern(f[2]);
+        }
+    });
+    return true;
+}
+
+
+// --- CITY-WIDE RASTERS ---
+// The 15x15 grid above is the demo district. City-wide rasters (10k x 10k cells) do not fit
+// the recursive DFS: one large hotspot needs one stack frame per cell. The labeling below is
+// a two-pass union-find over horizontal tiles instead, with no recursion at all.
+
+/**
+ * @brief A rows x cols crime-score raster, stored row-major (cell index = r * cols + c).
+ */
+struct CrimeRaster {
+    int rows = 0, cols = 0;
+    vector<int> score;
+
+    void resize(int r, int c) { rows = r; cols = c; score.assign((size_t)r * c, 0); }
+    int at(int r, int c) const { return score[(size_t)r * cols + c]; }
+};
+
+/**
+ * @brief A connected high-crime cluster: its severity score and its starting cell (1-based),
+ * which is the first cell of the cluster in row-major order, as in the DFS scan.
+ */
+struct Hotspot {
+    long long score;
+    int row, col;
+};
+
+/**
+ * @brief Orders hotspots exactly as cluster_max_heap pops them: highest score first, ties
+ * broken by the larger row, then the larger column.
+ */
+bool outranks(const Hotspot& a, const Hotspot& b) {
+    return tie(a.score, a.row, a.col) > tie(b.score, b.row, b.col);
+}
+
+/**
+ * @brief Keeps the 'k' highest-ranked hotspots, in rank order.
+ */
+vector<Hotspot> top_hotspots(vector<Hotspot> spots, int k) {
+    size_t keep = min(spots.size(), (size_t)max(k, 0));
+    partial_sort(spots.begin(), spots.begin() + keep, spots.end(), outranks);
+    spots.resize(keep);
+    return spots;
+}
+
+/**
+ * @brief Union-find root with path halving. Roots are always the smallest cell index of their
+ * set, so the root of a cluster is its row-major starting cell.
+ */
+int find_root(vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+void unite(vector<int>& parent, int a, int b) {
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
+}
+
+/**
+ * @brief Two-pass connected-component labeling of all cells with score >= threshold
+ * (4-way connectivity), returning every cluster with its severity score.
+ *
+ * Pass 1 labels each tile of TILE_ROWS rows on its own (tiles run on 'threads' workers, and a
+ * tile only ever touches its own cells), and sums scores at the tile-local roots.
+ * Pass 2 merges the tiles along their borders and folds each tile-local sum into its
+ * city-wide cluster.
+ */
+vector<Hotspot> label_hotspots(const CrimeRaster& grid, int threshold, int threads = 1) {
+    const int TILE_ROWS = 64;
+    int rows = grid.rows, cols = grid.cols;
+    int tiles = (rows + TILE_ROWS - 1) / TILE_ROWS;
+    vector<int> parent((size_t)rows * cols, -1); // -1: below threshold
+    vector<vector<pair<int, long long>>> tile_roots(tiles); // (tile-local root, tile-local sum)
+
+    auto label_tile = [&](int t) {
+        int r0 = t * TILE_ROWS, r1 = min(rows, r0 + TILE_ROWS);
+        for (int r = r0; r < r1; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                int i = r * cols + c;
+                if (grid.score[i] < threshold) continue;
+                parent[i] = i;
+                if (c > 0 && parent[i - 1] >= 0) unite(parent, i - 1, i);
+                if (r > r0 && parent[i - cols] >= 0) unite(parent, i - cols, i);
+            }
+        }
+        // Sum each tile-local cluster at its root; a tile's roots lie inside the tile.
+        vector<long long> sum((size_t)(r1 - r0) * cols, 0);
+        int base = r0 * cols;
+        for (int i = base; i < r1 * cols; ++i) {
+            if (parent[i] >= 0) sum[find_root(parent, i) - base] += grid.score[i];
         }
+        for (int i = base; i < r1 * cols; ++i) {
+            if (parent[i] == i) tile_roots[t].push_back({i, sum[i - base]});
+        }
+    };
+
+    vector<thread> workers;
+    int worker_count = max(1, min(threads, tiles));
+    for (int w = 0; w < worker_count; ++w) {
+        workers.emplace_back([&, w] {
+            for (int t = w; t < tiles; t += worker_count) label_tile(t);
+        });
     }
+    for (auto& worker : workers) worker.join();
+
+    // Pass 2: stitch each tile's first row to the row above it.
+    for (int t = 1; t < tiles; ++t) {
+        int i = t * TILE_ROWS * cols;
+        for (int c = 0; c < cols; ++c, ++i) {
+            if (parent[i] >= 0 && parent[i - cols] >= 0) unite(parent, i - cols, i);
+        }
+    }
+
+    vector<Hotspot> spots;
+    for (auto& roots : tile_roots) {
+        for (auto& entry : roots) {
+            if (parent[entry.first] != entry.first) continue;
+            spots.push_back({0, entry.first / cols + 1, entry.first % cols + 1});
+        }
+    }
+    // Clusters are numbered in row-major order of their roots, so a binary search finds them.
+    for (auto& roots : tile_roots) {
+        for (auto& entry : roots) {
+            int root = find_root(parent, entry.first);
+            Hotspot key = {0, root / cols + 1, root % cols + 1};
+            auto it = lower_bound(spots.begin(), spots.end(), key, [](const Hotspot& a, const Hotspot& b) {
+                return tie(a.row, a.col) < tie(b.row, b.col);
+            });
+            it->score += entry.second;
+        }
+    }
+    // An all-zero cluster (threshold <= 0) has no severity; the DFS scan does not report it.
+    spots.erase(remove_if(spots.begin(), spots.end(), [](const Hotspot& h) { return h.score <= 0; }), spots.end());
+    return spots;
 }
 
+/**
+ * @brief The dfs_cluster scan applied to a raster: recursive DFS from each unvisited cell, one
+ * stack frame per cell of the cluster. Kept as the reference for label_hotspots.
+ */
+long long dfs_raster(const CrimeRaster& grid, vector<char>& seen, int r, int c, int threshold) {
+    if (r < 0 || r >= grid.rows || c < 0 || c >= grid.cols) return 0;
+    size_t i = (size_t)r * grid.cols + c;
+    if (seen[i] || grid.score[i] < threshold) return 0;
+    seen[i] = true;
+    long long total = grid.score[i];
+    for (int d = 0; d < NUM_DIRECTIONS; ++d) total += dfs_raster(grid, seen, r + DR[d], c + DC[d], threshold);
+    return total;
+}
+
+vector<Hotspot> dfs_hotspots(const CrimeRaster& grid, int threshold) {
+    vector<char> seen((size_t)grid.rows * grid.cols, false);
+    vector<Hotspot> spots;
+    for (int i = 0; i < grid.rows; ++i) {
+        for (int j = 0; j < grid.cols; ++j) {
+            if (grid.at(i, j) >= threshold && !seen[(size_t)i * grid.cols + j]) {
+                long long score = dfs_raster(grid, seen, i, j, threshold);
+                if (score > 0) spots.push_back({score, i + 1, j + 1});
+            }
+        }
+    }
+    return spots;
+}
+
+/**
+ * @brief Runs 'job' on a thread with a stack of 'stack_bytes', so the recursive DFS can be
+ * measured on rasters whose clusters would overflow the default 8 MB stack.
+ */
+bool run_with_stack(size_t stack_bytes, const function<void()>& job) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stack_bytes);
+    pthread_t tid;
+    auto trampoline = [](void* arg) -> void* {
+        (*static_cast<const function<void()>*>(arg))();
+        return nullptr;
+    };
+    bool ok = pthread_create(&tid, &attr, trampoline, (void*)&job) == 0;
+    if (ok) pthread_join(tid, nullptr);
+    pthread_attr_destroy(&attr);
+    return ok;
+}
+
+/**
+ * @brief Synthetic city raster: smooth neighbourhood crime levels (bilinear over a coarse
+ * 48-cell lattice) plus per-cell noise, scores 0-9. Produces large, irregular hotspots.
+ */
+void synthesize_raster(CrimeRaster& grid, int rows, int cols, unsigned seed) {
+    const int CELL = 48;
+    grid.resize(rows, cols);
+    mt19937 rng(seed);
+    int lr = rows / CELL + 2, lc = cols / CELL + 2;
+    vector<float> level((size_t)lr * lc);
+    for (auto& v : level) v = (float)(rng() % 1100) / 100.0f;
+    for (int r = 0; r < rows; ++r) {
+        int gr = r / CELL;
+        float fr = (float)(r % CELL) / CELL;
+        for (int c = 0; c < cols; ++c) {
+            int gc = c / CELL;
+            float fc = (float)(c % CELL) / CELL;
+            const float* top = &level[(size_t)gr * lc + gc];
+            const float* bottom = top + lc;
+            float v = (top[0] * (1 - fc) + top[1] * fc) * (1 - fr) + (bottom[0] * (1 - fc) + bottom[1] * fc) * fr;
+            v += (float)((int)(rng() % 5) - 2);
+            grid.score[(size_t)r * cols + c] = min(9, max(0, (int)v));
+        }
+    }
+}
+
+double ms_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Times label_hotspots against the recursive DFS on growing rasters and checks that the
+ * severity scores and the top-k ranking agree. Rasters above 4096 x 4096 run union-find only.
+ */
+int run_benchmark(const vector<int>& sizes, int threshold, int k) {
+    int threads = max(1u, thread::hardware_concurrency());
+    int mismatches = 0;
+    printf("Threshold %d, top %d, %d thread(s)\n\n", threshold, k, threads);
+    printf("%-13s %10s %12s %12s %14s %14s\n", "raster", "clusters", "largest", "DFS ms", "UF 1-thread ms",
+           "UF all ms");
+    for (int n : sizes) {
+        CrimeRaster grid;
+        synthesize_raster(grid, n, n, 42 + n);
+
+        auto t0 = chrono::steady_clock::now();
+        vector<Hotspot> single = label_hotspots(grid, threshold, 1);
+        double uf1 = ms_since(t0);
+        t0 = chrono::steady_clock::now();
+        vector<Hotspot> parallel = label_hotspots(grid, threshold, threads);
+        double ufn = ms_since(t0);
+
+        long long largest = 0;
+        for (auto& h : single) largest = max(largest, h.score);
+        vector<Hotspot> top = top_hotspots(single, k);
+        auto same = [](const vector<Hotspot>& a, const vector<Hotspot>& b) {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (a[i].score != b[i].score || a[i].row != b[i].row || a[i].col != b[i].col) return false;
+            }
+            return true;
+        };
+        if (!same(single, parallel)) mismatches++;
+
+        string dfs_time = "skipped";
+        if ((long long)n * n <= 4096LL * 4096) {
+            vector<Hotspot> reference;
+            double dfs_ms = 0;
+            run_with_stack((size_t)n * n * 160 + (64 << 20), [&] {
+                auto start = chrono::steady_clock::now();
+                reference = dfs_hotspots(grid, threshold);
+                dfs_ms = ms_since(start);
+            });
+            dfs_time = to_string((long long)dfs_ms);
+            if (!same(top, top_hotspots(reference, k)) || reference.size() != single.size()) mismatches++;
+        }
+        string label = to_string(n) + " x " + to_string(n);
+        printf("%-13s %10zu %12lld %12s %14.0f %14.0f\n", label.c_str(), single.size(), largest, dfs_time.c_str(), uf1,
+               ufn);
+    }
+    printf("\n%d mismatch(es) against the DFS and between thread counts\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// --- THRESHOLD SWEEP ---
+// Analysts try thresholds 1..10 one after another. Every cluster at any threshold is a node
+// of one component tree (max-tree): the clusters at threshold t are the nodes with level >= t
+// whose parent has level < t. The tree is built once, with union-find over the cells in
+// descending score order; each threshold is then a lookup.
+
+/**
+ * @brief Component tree of a raster: one node per distinct (threshold, cluster) pair.
+ */
+class HotspotTree {
+    struct Node {
+        int level;         // Lowest score in the cluster: the highest threshold it exists at
+        int parent_level;  // Level of the enclosing cluster (INT_MIN for a top-level cluster)
+        int start;         // Row-major starting cell
+        long long sum;     // Severity score
+    };
+    int cols = 0;
+    vector<Node> nodes;   // Sorted by level (descending), then parent_level (ascending)
+    vector<int> levels;   // Distinct levels, descending
+    vector<int> first;    // Nodes of levels[i] are nodes[first[i] .. first[i + 1])
+
+public:
+    /**
+     * @brief Builds the tree in O(cells * alpha) after a counting sort of the scores.
+     */
+    void build(const CrimeRaster& grid) {
+        cols = grid.cols;
+        size_t cells = (size_t)grid.rows * grid.cols;
+        nodes.clear(); levels.clear(); first.clear();
+        if (cells == 0) return;
+
+        // Counting sort of the cells by score, highest first.
+        int lo = *min_element(grid.score.begin(), grid.score.end());
+        int hi = *max_element(grid.score.begin(), grid.score.end());
+        vector<int> order(cells), offset((size_t)(hi - lo) + 2, 0);
+        for (int s : grid.score) offset[hi - s + 1]++;
+        for (size_t v = 1; v < offset.size(); ++v) offset[v] += offset[v - 1];
+        for (size_t i = 0; i < cells; ++i) order[offset[hi - grid.score[i]]++] = (int)i;
+
+        // Build nodes. A node that meets another node of its own level absorbs it; the
+        // absorbed node keeps 'parent' pointing at the survivor and is dropped afterwards.
+        struct Raw { int level, parent, start; long long sum; bool alive; };
+        vector<Raw> raw;
+        vector<int> parent(cells, -1), node_of(cells, -1);
+        for (int p : order) {
+            int level = grid.score[p];
+            int r = p / cols, c = p % cols;
+            int neighbours[NUM_DIRECTIONS], count = 0;
+            for (int d = 0; d < NUM_DIRECTIONS; ++d) {
+                int nr = r + DR[d], nc = c + DC[d];
+                if (nr < 0 || nr >= grid.rows || nc < 0 || nc >= cols) continue;
+                int q = nr * cols + nc;
+                if (parent[q] >= 0) neighbours[count++] = find_root(parent, q);
+            }
+            // Join a neighbouring cluster of this level if there is one, else open a new node.
+            int node = -1;
+            for (int i = 0; i < count && node < 0; ++i) {
+                if (raw[node_of[neighbours[i]]].level == level) node = node_of[neighbours[i]];
+            }
+            if (node < 0) {
+                node = (int)raw.size();
+                raw.push_back({level, -1, p, 0, true});
+            }
+            raw[node].sum += level;
+            raw[node].start = min(raw[node].start, p);
+            parent[p] = p;
+            int root = p;
+            for (int i = 0; i < count; ++i) {
+                int other = find_root(parent, neighbours[i]);
+                if (other == root) continue;
+                int child = node_of[other];
+                if (child != node) {
+                    raw[child].parent = node;
+                    if (raw[child].level == level) raw[child].alive = false;
+                    raw[node].sum += raw[child].sum;
+                    raw[node].start = min(raw[node].start, raw[child].start);
+                }
+                if (other < root) swap(other, root);
+                parent[other] = root;
+            }
+            node_of[root] = node;
+        }
+
+        // Skip absorbed nodes on the way up, shortening the chains as they are walked.
+        auto alive_parent = [&](int v) {
+            int up = raw[v].parent;
+            while (up >= 0 && !raw[up].alive) {
+                int next = raw[up].parent;
+                if (next >= 0 && !raw[next].alive) raw[up].parent = raw[next].parent;
+                up = raw[up].parent;
+            }
+            return up;
+        };
+        for (size_t v = 0; v < raw.size(); ++v) {
+            if (!raw[v].alive) continue;
+            int up = alive_parent((int)v);
+            nodes.push_back({raw[v].level, up < 0 ? INT_MIN : raw[up].level, raw[v].start, raw[v].sum});
+        }
+        sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) {
+            return tie(b.level, a.parent_level) < tie(a.level, b.parent_level);
+        });
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (i == 0 || nodes[i].level != nodes[i - 1].level) {
+                levels.push_back(nodes[i].level);
+                first.push_back((int)i);
+            }
+        }
+        first.push_back((int)nodes.size());
+    }
+
+    /**
+     * @brief Clusters with score >= threshold, in O(output + distinct levels >= threshold).
+     */
+    vector<Hotspot> clusters(int threshold) const {
+        vector<Hotspot> spots;
+        for (size_t i = 0; i < levels.size() && levels[i] >= threshold; ++i) {
+            for (int j = first[i]; j < first[i + 1] && nodes[j].parent_level < threshold; ++j) {
+                if (nodes[j].sum > 0) spots.push_back({nodes[j].sum, nodes[j].start / cols + 1, nodes[j].start % cols + 1});
+            }
+        }
+        return spots;
+    }
+
+    size_t node_count() const { return nodes.size(); }
+};
+
+/**
+ * @brief Prints a ranking in the format of the interactive tool.
+ */
+void print_ranking(const vector<Hotspot>& spots, int threshold, int max_clusters) {
+    vector<Hotspot> top = top_hotspots(spots, max_clusters);
+    cout << "\n--- TOP " << max_clusters << " HIGH-CRIME HOTSPOT RANKING (threshold " << threshold << ") ---\n";
+    if (top.empty()) {
+        cout << "No connected high-crime clusters found above the threshold of " << threshold << ".\n";
+        return;
+    }
+    int rank = 1;
+    for (auto& h : top) {
+        cout << "------------------------------------------\n";
+        cout << "RANK " << rank++ << " (Deployment Priority)\n";
+        cout << "  Severity Score: " << h.score << "\n";
+        cout << "  Starting Area:  " << place_name_at(h.row - 1, h.col - 1) << "\n";
+        cout << "  Grid Location:  [Row " << h.row << ", Col " << h.col << "]\n";
+    }
+    if (spots.size() > top.size()) {
+        cout << "\nNote: " << spots.size() - top.size() << " additional high-crime clusters remain unranked in the top list.\n";
+    }
+}
+
+/**
+ * @brief Times one tree build plus a 1..10 threshold sweep against re-clustering the raster
+ * for every threshold, and checks that both give the same clusters.
+ */
+int run_sweep_benchmark(const vector<int>& sizes) {
+    int mismatches = 0;
+    printf("Sweep over thresholds 1..10\n\n");
+    printf("%-13s %10s %12s %14s %16s\n", "raster", "tree nodes", "build ms", "sweep ms", "re-cluster ms");
+    for (int n : sizes) {
+        CrimeRaster grid;
+        synthesize_raster(grid, n, n, 42 + n);
+        HotspotTree tree;
+        auto t0 = chrono::steady_clock::now();
+        tree.build(grid);
+        double build_ms = ms_since(t0);
+
+        vector<vector<Hotspot>> answers;
+        t0 = chrono::steady_clock::now();
+        for (int t = 1; t <= 10; ++t) answers.push_back(tree.clusters(t));
+        double sweep_ms = ms_since(t0);
+
+        vector<vector<Hotspot>> reference;
+        t0 = chrono::steady_clock::now();
+        for (int t = 1; t <= 10; ++t) reference.push_back(label_hotspots(grid, t));
+        double recluster_ms = ms_since(t0);
+
+        auto by_cell = [](const Hotspot& a, const Hotspot& b) { return tie(a.row, a.col) < tie(b.row, b.col); };
+        for (int t = 0; t < 10; ++t) {
+            sort(answers[t].begin(), answers[t].end(), by_cell);
+            sort(reference[t].begin(), reference[t].end(), by_cell);
+            bool same = answers[t].size() == reference[t].size();
+            for (size_t i = 0; same && i < answers[t].size(); ++i) {
+                same = answers[t][i].score == reference[t][i].score && answers[t][i].row == reference[t][i].row &&
+                       answers[t][i].col == reference[t][i].col;
+            }
+            if (!same) mismatches++;
+        }
+        string label = to_string(n) + " x " + to_string(n);
+        printf("%-13s %10zu %12.0f %14.1f %16.0f\n", label.c_str(), tree.node_count(), build_ms, sweep_ms, recluster_ms);
+    }
+    printf("\n%d mismatch(es) against re-clustering\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Interactive sweep over the demo grid: the tree is built once, then every threshold
+ * the analyst enters is answered from it.
+ */
+int run_sweep() {
+    CrimeRaster grid;
+    grid.resize(ROWS, COLS);
+    for (int i = 0; i < ROWS; ++i)
+        for (int j = 0; j < COLS; ++j) grid.score[get_key(i, j)] = crime_grid[i][j];
+    HotspotTree tree;
+    tree.build(grid);
+
+    int threshold, max_clusters;
+    cout << "--- Police Resource Deployment Prioritization Tool (threshold sweep) ---\n";
+    while (true) {
+        cout << "\nEnter the **minimum crime score threshold** (or -1 to exit): ";
+        if (!(cin >> threshold) || threshold < 0) break;
+        cout << "Enter the **maximum number of clusters (hotspots)** to rank: ";
+        if (!(cin >> max_clusters)) break;
+        print_ranking(tree.clusters(threshold), threshold, max_clusters);
+    }
+    return 0;
+}
+
+// --- STREAMING HOTSPOTS ---
+// A live incident feed keeps the raster current: every incident adds its crime score to its
+// cell for 'window' seconds (e.g. the last 24h) and is then subtracted again. Cell updates are
+// O(1); they only mark their tile dirty. When a ranking is requested, dirty tiles are
+// relabeled on their own and the per-tile clusters are stitched along tile borders, so the
+// cost of a ranking follows what changed rather than the size of the city.
+
+/**
+ * @brief One incident from the feed: time in seconds, 0-based cell, crime score.
+ */
+struct Incident {
+    long long time;
+    int cell;
+    int score;
+};
+
+/**
+ * @brief Sliding-window cell scores with on-demand hotspot ranking.
+ */
+class HotspotWindow {
+    static const int TILE = 64;
+
+    struct TileCluster {
+        long long sum;
+        int start;   // Row-major starting cell
+    };
+
+    CrimeRaster grid;
+    long long window;
+    int threshold;
+    deque<Incident> live;
+    int tile_rows, tile_cols;
+    vector<char> dirty;
+    vector<vector<TileCluster>> tile_clusters;
+    vector<int> local;   // Per cell: index of its cluster within its tile, -1 below threshold
+    vector<int> stack;
+
+    // Only a cell crossing the threshold changes cluster shapes and dirties its tile; inside a
+    // clean tile, a cell that stays above it just adjusts its cluster's sum.
+    void touch(int cell, int delta) {
+        int before = grid.score[cell];
+        grid.score[cell] += delta;
+        int r = cell / grid.cols, c = cell % grid.cols;
+        int tile = (r / TILE) * tile_cols + c / TILE;
+        bool was_hot = before >= threshold, is_hot = grid.score[cell] >= threshold;
+        if (was_hot != is_hot) dirty[tile] = true;
+        else if (is_hot && !dirty[tile]) tile_clusters[tile][local[cell]].sum += delta;
+    }
+
+    // Flood-fills one tile (explicit stack; a tile has at most TILE * TILE cells).
+    void relabel(int tile) {
+        int r0 = tile / tile_cols * TILE, c0 = tile % tile_cols * TILE;
+        int r1 = min(grid.rows, r0 + TILE), c1 = min(grid.cols, c0 + TILE);
+        vector<TileCluster>& clusters = tile_clusters[tile];
+        clusters.clear();
+        for (int r = r0; r < r1; ++r)
+            for (int c = c0; c < c1; ++c) local[r * grid.cols + c] = -1;
+        for (int r = r0; r < r1; ++r) {
+            for (int c = c0; c < c1; ++c) {
+                int seed = r * grid.cols + c;
+                if (local[seed] >= 0 || grid.score[seed] < threshold) continue;
+                int id = (int)clusters.size();
+                clusters.push_back({0, seed});
+                local[seed] = id;
+                stack.push_back(seed);
+                while (!stack.empty()) {
+                    int cell = stack.back();
+                    stack.pop_back();
+                    clusters[id].sum += grid.score[cell];
+                    int cr = cell / grid.cols, cc = cell % grid.cols;
+                    for (int d = 0; d < NUM_DIRECTIONS; ++d) {
+                        int nr = cr + DR[d], nc = cc + DC[d];
+                        if (nr < r0 || nr >= r1 || nc < c0 || nc >= c1) continue;
+                        int next = nr * grid.cols + nc;
+                        if (local[next] < 0 && grid.score[next] >= threshold) {
+                            local[next] = id;
+                            stack.push_back(next);
+                        }
+                    }
+                }
+            }
+        }
+        dirty[tile] = false;
+    }
+
+public:
+    HotspotWindow(int rows, int cols, long long window_seconds, int min_score)
+        : window(window_seconds), threshold(min_score) {
+        grid.resize(rows, cols);
+        tile_rows = (rows + TILE - 1) / TILE;
+        tile_cols = (cols + TILE - 1) / TILE;
+        dirty.assign((size_t)tile_rows * tile_cols, true);
+        tile_clusters.assign((size_t)tile_rows * tile_cols, {});
+        local.assign((size_t)rows * cols, -1);
+    }
+
+    /**
+     * @brief Drops incidents older than the window ending at 'now'.
+     */
+    void advance(long long now) {
+        while (!live.empty() && live.front().time <= now - window) {
+            touch(live.front().cell, -live.front().score);
+            live.pop_front();
+        }
+    }
+
+    /**
+     * @brief Adds an incident at 0-based (r, c). Incidents must arrive in time order.
+     */
+    void add(long long time, int r, int c, int score) {
+        advance(time);
+        int cell = r * grid.cols + c;
+        live.push_back({time, cell, score});
+        touch(cell, score);
+    }
+
+    /**
+     * @brief The 'k' highest-ranked hotspots in the current window.
+     */
+    vector<Hotspot> top(int k) {
+        size_t tiles = tile_clusters.size();
+        for (size_t t = 0; t < tiles; ++t) {
+            if (dirty[t]) relabel((int)t);
+        }
+        // Stitch: tile clusters get global ids, joined by union-find across tile borders.
+        vector<int> base(tiles + 1, 0);
+        for (size_t t = 0; t < tiles; ++t) base[t + 1] = base[t] + (int)tile_clusters[t].size();
+        vector<int> parent(base[tiles]);
+        for (int i = 0; i < base[tiles]; ++i) parent[i] = i;
+        auto id_of = [&](int cell) {
+            int r = cell / grid.cols, c = cell % grid.cols;
+            return base[(r / TILE) * tile_cols + c / TILE] + local[cell];
+        };
+        auto join = [&](int a, int b) {
+            if (local[a] >= 0 && local[b] >= 0) unite(parent, id_of(a), id_of(b));
+        };
+        for (int c = TILE; c < grid.cols; c += TILE)
+            for (int r = 0; r < grid.rows; ++r) join(r * grid.cols + c - 1, r * grid.cols + c);
+        for (int r = TILE; r < grid.rows; r += TILE)
+            for (int c = 0; c < grid.cols; ++c) join((r - 1) * grid.cols + c, r * grid.cols + c);
+
+        vector<Hotspot> merged(base[tiles], Hotspot{0, INT_MAX, 0});
+        vector<int> start(base[tiles], INT_MAX);
+        for (size_t t = 0; t < tiles; ++t) {
+            for (size_t i = 0; i < tile_clusters[t].size(); ++i) {
+                int root = find_root(parent, base[t] + (int)i);
+                merged[root].score += tile_clusters[t][i].sum;
+                start[root] = min(start[root], tile_clusters[t][i].start);
+            }
+        }
+        vector<Hotspot> spots;
+        for (int i = 0; i < base[tiles]; ++i) {
+            if (parent[i] == i && merged[i].score > 0)
+                spots.push_back({merged[i].score, start[i] / grid.cols + 1, start[i] % grid.cols + 1});
+        }
+        return top_hotspots(spots, k);
+    }
+
+    const CrimeRaster& raster() const { return grid; }
+    size_t live_incidents() const { return live.size(); }
+};
+
+/**
+ * @brief Reads a feed from stdin: "time,row,col,crime_score" lines (time in seconds, 1-based
+ * row and column) and "top" lines, which print the current ranking.
+ */
+int run_stream(int rows, int cols, long long window, int threshold, int k) {
+    HotspotWindow hotspots(rows, cols, window, threshold);
+    string line;
+    long long now = 0;
+    while (getline(cin, line)) {
+        if (line.compare(0, 3, "top") == 0) {
+            hotspots.advance(now);
+            vector<Hotspot> top = hotspots.top(k);
+            printf("time %lld: %zu incident(s) in window\n", now, hotspots.live_incidents());
+            int rank = 1;
+            for (auto& h : top) printf("  RANK %d  severity %lld  [Row %d, Col %d]\n", rank++, h.score, h.row, h.col);
+            fflush(stdout);
+            continue;
+        }
+        long long time;
+        int r, c, score;
+        if (sscanf(line.c_str(), "%lld,%d,%d,%d", &time, &r, &c, &score) != 4) continue;
+        if (r < 1 || r > rows || c < 1 || c > cols || time < now) continue;
+        now = time;
+        hotspots.add(time, r - 1, c - 1, score);
+    }
+    return 0;
+}
+
+/**
+ * @brief Replays a synthetic 48h feed over a city raster with drifting hotspots, asking for
+ * the top-k every 'query_every' incidents, and checks rankings against full re-clustering.
+ */
+int run_stream_benchmark(int size, int events, int query_every) {
+    const long long WINDOW = 24 * 3600;
+    const int THRESHOLD = 12, K = 10;
+    mt19937 rng(7);
+    normal_distribution<double> spread(0.0, 25.0);
+    vector<Incident> feed(events);
+    vector<pair<double, double>> centres(40);
+    for (auto& ct : centres) ct = {(double)(rng() % size), (double)(rng() % size)};
+    for (int i = 0; i < events; ++i) {
+        auto& ct = centres[rng() % centres.size()];
+        ct.first = min(size - 1.0, max(0.0, ct.first + (rng() % 3 - 1.0) * 0.05));
+        ct.second = min(size - 1.0, max(0.0, ct.second + (rng() % 3 - 1.0) * 0.05));
+        int r = min(size - 1, max(0, (int)(ct.first + spread(rng))));
+        int c = min(size - 1, max(0, (int)(ct.second + spread(rng))));
+        if (rng() % 4 == 0) { r = rng() % size; c = rng() % size; } // background incidents
+        feed[i] = {(long long)i * 2 * WINDOW / events, r * size + c, 1 + (int)(rng() % 5)};
+    }
+    printf("City %d x %d, %d incidents over 48h, 24h window, threshold %d, top %d every %d incidents\n\n", size, size,
+           events, THRESHOLD, K, query_every);
+
+    HotspotWindow ingest_only(size, size, WINDOW, THRESHOLD);
+    auto t0 = chrono::steady_clock::now();
+    for (auto& e : feed) ingest_only.add(e.time, e.cell / size, e.cell % size, e.score);
+    double ingest_ms = ms_since(t0);
+
+    HotspotWindow hotspots(size, size, WINDOW, THRESHOLD);
+    vector<double> latencies;
+    int mismatches = 0, checks = 0;
+    double checked_ms = 0;
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < events; ++i) {
+        hotspots.add(feed[i].time, feed[i].cell / size, feed[i].cell % size, feed[i].score);
+        if ((i + 1) % query_every != 0) continue;
+        auto q0 = chrono::steady_clock::now();
+        vector<Hotspot> top = hotspots.top(K);
+        latencies.push_back(ms_since(q0));
+        if (latencies.size() % 10 == 0) {
+            auto c0 = chrono::steady_clock::now();
+            vector<Hotspot> reference = top_hotspots(label_hotspots(hotspots.raster(), THRESHOLD), K);
+            checks++;
+            bool same = reference.size() == top.size();
+            for (size_t j = 0; same && j < top.size(); ++j)
+                same = top[j].score == reference[j].score && top[j].row == reference[j].row && top[j].col == reference[j].col;
+            if (!same) mismatches++;
+            checked_ms += ms_since(c0);
+        }
+    }
+    double replay_ms = ms_since(t0) - checked_ms;
+    sort(latencies.begin(), latencies.end());
+    printf("Ingest only:        %.0f ms, %.2f M incidents/s\n", ingest_ms, events / ingest_ms / 1000.0);
+    printf("Ingest + rankings:  %.0f ms, %.2f M incidents/s (%zu rankings)\n", replay_ms, events / replay_ms / 1000.0,
+           latencies.size());
+    if (!latencies.empty()) {
+        printf("Ranking latency:    p50 %.2f ms, p99 %.2f ms (full re-clustering: %.2f ms)\n",
+               latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+               checks ? checked_ms / checks : 0.0);
+    }
+    printf("\n%d mismatch(es) in %d ranking checks against full re-clustering\n", mismatches, checks);
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Loads a crime.csv file (row,col,place_name,crime_score; 1-based row and column) into
+ * a raster sized to fit it, with an interned place ID per cell (-1 where no row names it).
+ * @return Number of records loaded, or -1 if the file cannot be read.
+ */
+long long load_crime_raster(const string& path, CrimeRaster& grid, vector<int>& place_of_cell, PlaceNames& names) {
+    MappedCsv csv;
+    if (!csv.open(path)) return -1;
+    struct Record { int r, c, place, score; };
+    vector<Record> records;
+    int rows = 0, cols = 0;
+    csv.for_each_row([&](const string_view* f, int count) {
+        Record rec;
+        if (count < 4 || !parse_int(f[0], rec.r) || !parse_int(f[1], rec.c) || !parse_int(f[3], rec.score)) return;
+        if (rec.r < 1 || rec.c < 1) return;
+        rec.place = names.intern(f[2]);
+        rows = max(rows, rec.r);
+        cols = max(cols, rec.c);
+        records.push_back(rec);
+    });
+    grid.resize(rows, cols);
+    place_of_cell.assign((size_t)rows * cols, -1);
+    for (auto& rec : records) {
+        size_t cell = (size_t)(rec.r - 1) * cols + rec.c - 1;
+        grid.score[cell] = rec.score;
+        place_of_cell[cell] = rec.place;
+    }
+    return (long long)records.size();
+}
+
+
+/**
+ * @brief The conventional loader, for comparison: getline per line and per field into
+ * std::strings, stoi for numbers, names kept per cell in a map as place_name_map does.
+ */
+long long load_crime_raster_strings(const string& path, CrimeRaster& grid, map<int, string>& names_by_cell) {
+    ifstream in(path);
+    if (!in) return -1;
+    struct Record { int r, c, score; string place; };
+    vector<Record> records;
+    int rows = 0, cols = 0;
+    string line, row_text, col_text, place, score_text;
+    getline(in, line); // Header
+    while (getline(in, line)) {
+        stringstream ss(line);
+        if (!getline(ss, row_text, ',') || !getline(ss, col_text, ',') || !getline(ss, place, ',') ||
+            !getline(ss, score_text)) continue;
+        Record rec = {stoi(row_text), stoi(col_text), stoi(score_text), place};
+        rows = max(rows, rec.r);
+        cols = max(cols, rec.c);
+        records.push_back(move(rec));
+    }
+    grid.resize(rows, cols);
+    for (auto& rec : records) {
+        grid.score[(size_t)(rec.r - 1) * cols + rec.c - 1] = rec.score;
+        names_by_cell[(rec.r - 1) * cols + rec.c - 1] = move(rec.place);
+    }
+    return (long long)records.size();
+}
+
+/**
+ * @brief Writes a rows x cols synthetic crime.csv (districts of 40 x 40 cells share a name),
+ * then measures the string loader, the bare mapped tokenizer, and the full mapped loader.
+ */
+int run_csv_benchmark(const string& path, int rows, int cols) {
+    static const char* AREAS[] = {"Central Market", "Railway Station Road", "Old Bus Stand", "Shopping Street",
+                                  "Residential Block A", "Residential Block B", "Old City", "Slum Area", "IT Park",
+                                  "Commercial Hub", "Airport Road", "Industrial Area"};
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out) {
+        cerr << "Could not write " << path << "\n";
+        return 1;
+    }
+    mt19937 rng(20);
+    fprintf(out, "row,col,place_name,crime_score\n");
+    for (int r = 1; r <= rows; ++r)
+        for (int c = 1; c <= cols; ++c)
+            fprintf(out, "%d,%d,%s %d,%d\n", r, c, AREAS[(r / 40 + c / 40) % 12], (r / 40) * 1000 + c / 40,
+                    (int)(rng() % 10));
+    fclose(out);
+
+    MappedCsv csv;
+    csv.open(path);
+    double gb = csv.size() / 1e9;
+    printf("%s: %d x %d cells, %.2f GB\n\n", path.c_str(), rows, cols, gb);
+    printf("%-34s %10s %10s\n", "loader", "ms", "GB/s");
+
+    CrimeRaster slow_grid;
+    map<int, string> names_by_cell;
+    auto t0 = chrono::steady_clock::now();
+    long long slow_records = load_crime_raster_strings(path, slow_grid, names_by_cell);
+    double slow_ms = ms_since(t0);
+    printf("%-34s %10.0f %10.3f\n", "getline + stoi + map<int,string>", slow_ms, gb / (slow_ms / 1000));
+
+    long long checksum = 0;
+    t0 = chrono::steady_clock::now();
+    csv.for_each_row([&](const string_view* f, int count) {
+        int score;
+        if (count >= 4 && parse_int(f[3], score)) checksum += score + (long long)f[2].size();
+    });
+    double scan_ms = ms_since(t0);
+    printf("%-34s %10.0f %10.3f\n", "mmap tokenize + from_chars", scan_ms, gb / (scan_ms / 1000));
+
+    CrimeRaster grid;
+    vector<int> place_of_cell;
+    PlaceNames names;
+    t0 = chrono::steady_clock::now();
+    long long records = load_crime_raster(path, grid, place_of_cell, names);
+    double fast_ms = ms_since(t0);
+    printf("%-34s %10.0f %10.3f\n", "mmap load + interned names", fast_ms, gb / (fast_ms / 1000));
+
+    long long mismatches = records != slow_records || grid.score != slow_grid.score;
+    for (auto& entry : names_by_cell) mismatches += names.name(place_of_cell[entry.first]) != entry.second;
+    printf("\n%lld records, %zu distinct place names (names map held %zu copies), checksum %lld\n", records,
+           names.size(), names_by_cell.size(), checksum);
+    printf("%lld mismatch(es) between the loaders\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        // ./code bench [threshold k size...]
+        int threshold = argc > 2 ? atoi(argv[2]) : 5;
+        int k = argc > 3 ? atoi(argv[3]) : 10;
+        vector<int> sizes;
+        for (int i = 4; i < argc; ++i) sizes.push_back(atoi(argv[i]));
+        if (sizes.empty()) sizes = {500, 1000, 2000, 4000, 10000};
+        return run_benchmark(sizes, threshold, k);
+    }
+    if (argc > 1 && string(argv[1]) == "sweep-bench") {
+        // ./code sweep-bench [size...]
+        vector<int> sizes;
+        for (int i = 2; i < argc; ++i) sizes.push_back(atoi(argv[i]));
+        if (sizes.empty()) sizes = {500, 1000, 2000, 4000};
+        return run_sweep_benchmark(sizes);
+    }
+    if (argc > 5 && string(argv[1]) == "stream") {
+        // ./code stream <rows> <cols> <window_seconds> <threshold> [k] < feed
+        return run_stream(atoi(argv[2]), atoi(argv[3]), atoll(argv[4]), atoi(argv[5]), argc > 6 ? atoi(argv[6]) : 5);
+    }
+    if (argc > 1 && string(argv[1]) == "stream-bench") {
+        // ./code stream-bench [size events query_every]
+        return run_stream_benchmark(argc > 2 ? atoi(argv[2]) : 2000, argc > 3 ? atoi(argv[3]) : 2000000,
+                                    argc > 4 ? atoi(argv[4]) : 10000);
+    }
+    if (argc > 2 && string(argv[1]) == "csv-bench") {
+        // ./code csv-bench <out.csv> [rows cols]
+        return run_csv_benchmark(argv[2], argc > 3 ? atoi(argv[3]) : 3000, argc > 4 ? atoi(argv[4]) : 3000);
+    }
 
-int main() {
     // Dataset provided by the user (multiline string)
     const string dataset = 
         "row col place_name crime_score\n"
@@ -170,8 +1238,21 @@ int main() {
         "15 8 Industrial Belt 6\n15 9 Industrial Belt 7\n15 10 Airport Zone 8\n15 11 Airport Zone 3\n"
         "15 12 Airport Zone 1\n15 13 Airport Zone 6\n15 14 Industrial Belt 7\n15 15 Industrial Belt 8\n";
         
-    // 1. Parse Data
-    parse_data(dataset);
+    // 1. Parse Data (a crime.csv given on the command line replaces the embedded dataset)
+    for (auto& row : place_id) fill(begin(row), end(row), -1);
+    bool sweep = argc > 1 && string(argv[1]) == "sweep";
+    const char* csv_path = sweep ? (argc > 2 ? argv[2] : nullptr) : (argc > 1 ? argv[1] : nullptr);
+    if (csv_path) {
+        if (!load_crime_csv(csv_path)) {
+            cerr << "Could not read " << csv_path << "\n";
+            return 1;
+        }
+    } else {
+        parse_data(dataset);
+    }
+    if (sweep) {
+        return run_sweep();
+    }
 
     // --- USER INPUT ---
     int threshold;
@@ -226,7 +1307,7 @@ int main() {
             int c = get<2>(top_cluster); // 1-based col
             
             // Get the place name for the starting coordinate
-            string place_name = place_name_map[get_key(r - 1, c - 1)];
+            const string& place_name = place_name_at(r - 1, c - 1);
 
             cout << "------------------------------------------\n";
             cout << "RANK " << rank++ << " (Deployment Priority)\n";
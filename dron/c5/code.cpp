@@ -8,6 +8,13 @@
 
     The code is fully scalable — more areas, roads, or cost values can be 
     added without changing the algorithmic logic.
+
+    Usage:
+        ./code                          MST of the built-in dataset
+        ./code <roads.csv>              MST of a dataset file (e.g. sample.csv)
+        ./code bench [areas edges]      string path vs integer-ID path (default 1M areas, 10M edges)
+        ./code plan [roads.csv]         MST, then add/close roads from stdin and see the cost change
+        ./code dynamic-bench [areas edges ops]   incremental updates vs recomputation
 */
 
 #include <iostream>
@@ -16,7 +23,19 @@
 #include <sstream>
 #include <algorithm>
 #include <map>
+#include <set>
 #include <numeric>
+#include <deque>
+#include <unordered_map>
+#include <string_view>
+#include <charconv>
+#include <array>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <cstdint>
+#include <cstdio>
 
 using namespace std;
 
@@ -26,6 +45,7 @@ using namespace std;
 class UnionFind {
 private:
     vector<int> parent;
+    vector<int> set_size;
     int num_sets;
 
 public:
@@ -33,24 +53,30 @@ public:
         // Initialize parent array: each element is its own parent
         parent.resize(n);
         iota(parent.begin(), parent.end(), 0); 
+        set_size.assign(n, 1);
     }
 
-    // Find the representative (root) of the set containing element i (with Path Compression)
+    // Find the representative (root) of the set containing element i (with Path Halving:
+    // every node on the way up is pointed at its grandparent, without recursion)
     int find(int i) {
-        if (parent[i] == i)
-            return i;
-        // Path compression: set parent[i] directly to the root
-        return parent[i] = find(parent[i]);
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
     }
 
-    // Unite the sets containing elements i and j (Union by Rank/Size can be added for optimization)
+    // Unite the sets containing elements i and j (Union by Size: the smaller tree goes under
+    // the larger one, so trees stay O(log n) deep)
     bool unite(int i, int j) {
         int root_i = find(i);
         int root_j = find(j);
 
         if (root_i != root_j) {
             // Merge the two sets
+            if (set_size[root_i] > set_size[root_j]) swap(root_i, root_j);
             parent[root_i] = root_j; 
+            set_size[root_j] += set_size[root_i];
             num_sets--;
             return true; // Union successful (no cycle formed)
         }
@@ -157,7 +183,723 @@ vector<Edge> kruskal_mst(vector<Edge>& edges, const map<string, int>& areas) {
 }
 
 
-int main() {
+// --- 4. Integer-ID Edge Pipeline ---
+// For utility networks with tens of millions of candidate edges: area names are interned to
+// dense integer IDs once, while parsing, and edges are packed 12-byte records sorted by a
+// parallel LSD radix sort on cost. The Kruskal loop then touches only integers.
+
+/**
+ * @brief A candidate edge between two interned areas (12 bytes).
+ */
+struct PackedEdge {
+    uint32_t from;
+    uint32_t to;
+    int32_t cost;
+};
+static_assert(sizeof(PackedEdge) == 12, "PackedEdge must stay 12 bytes");
+
+/**
+ * @brief Dense area IDs: each distinct name gets the next ID the first time it is seen.
+ */
+class AreaIndex {
+private:
+    deque<string> keys;                    // Names as they appear in the data (stable storage)
+    unordered_map<string_view, int> ids;   // Keys view into 'keys'
+    vector<string> names;                  // Display names ('_' shown as ' ')
+
+public:
+    int intern(string_view key) {
+        auto it = ids.find(key);
+        if (it != ids.end()) return it->second;
+        keys.emplace_back(key);
+        int id = (int)names.size();
+        ids.emplace(keys.back(), id);
+        names.push_back(keys.back());
+        replace(names.back().begin(), names.back().end(), '_', ' ');
+        return id;
+    }
+    int find(string_view key) const {
+        auto it = ids.find(key);
+        return it == ids.end() ? -1 : it->second;
+    }
+    const string& name(int id) const { return names[id]; }
+    int size() const { return (int)names.size(); }
+};
+
+/**
+ * @brief Parses "area_from area_to cost" records (whitespace- or comma-separated, one header
+ * line) straight into packed edges, interning area names as they are met.
+ * @param raw_data The dataset text.
+ * @param edges Output vector of packed edges.
+ * @param areas Output area index.
+ */
+void parse_edges(string_view raw_data, vector<PackedEdge>& edges, AreaIndex& areas) {
+    size_t pos = raw_data.find('\n');
+    pos = pos == string_view::npos ? raw_data.size() : pos + 1; // Skip the header line
+    auto separator = [](char ch) { return ch == ' ' || ch == ',' || ch == '\n' || ch == '\r' || ch == '\t'; };
+    auto next_token = [&]() {
+        while (pos < raw_data.size() && separator(raw_data[pos])) pos++;
+        size_t start = pos;
+        while (pos < raw_data.size() && !separator(raw_data[pos])) pos++;
+        return raw_data.substr(start, pos - start);
+    };
+    while (true) {
+        string_view from = next_token(), to = next_token(), cost_text = next_token();
+        if (cost_text.empty()) break;
+        int32_t cost = 0;
+        from_chars(cost_text.data(), cost_text.data() + cost_text.size(), cost);
+        uint32_t u = areas.intern(from);
+        uint32_t v = areas.intern(to);
+        edges.push_back({u, v, cost});
+    }
+}
+
+/**
+ * @brief Runs fn(t) for t = 0 .. threads-1, each on its own thread.
+ */
+template <class Fn>
+void parallel_for(int threads, Fn fn) {
+    vector<thread> workers;
+    for (int t = 1; t < threads; ++t) workers.emplace_back(fn, t);
+    fn(0);
+    for (auto& worker : workers) worker.join();
+}
+
+/**
+ * @brief Stable LSD radix sort of edges by cost, 8 bits per pass. Each thread counts and then
+ * scatters its own slice of the input; passes where every cost shares the digit are skipped.
+ * @param edges Edges to sort in place.
+ * @param threads Number of worker threads.
+ */
+void radix_sort_by_cost(vector<PackedEdge>& edges, int threads) {
+    size_t n = edges.size();
+    threads = max(1, min(threads, (int)(n / 65536) + 1));
+    vector<PackedEdge> buffer(n);
+    vector<array<size_t, 256>> counts(threads);
+    auto key = [](const PackedEdge& e) { return (uint32_t)e.cost ^ 0x80000000u; }; // Signed order
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        parallel_for(threads, [&](int t) {
+            counts[t].fill(0);
+            for (size_t i = n * t / threads; i < n * (t + 1) / threads; ++i) counts[t][(key(edges[i]) >> shift) & 255]++;
+        });
+        bool one_bucket = false;
+        for (int d = 0; d < 256 && !one_bucket; ++d) {
+            size_t total = 0;
+            for (int t = 0; t < threads; ++t) total += counts[t][d];
+            one_bucket = total == n;
+        }
+        if (one_bucket) continue;
+        // Turn counts into start offsets: digit-major, then thread order (keeps the sort stable).
+        size_t offset = 0;
+        for (int d = 0; d < 256; ++d) {
+            for (int t = 0; t < threads; ++t) {
+                size_t c = counts[t][d];
+                counts[t][d] = offset;
+                offset += c;
+            }
+        }
+        parallel_for(threads, [&](int t) {
+            array<size_t, 256>& next = counts[t];
+            for (size_t i = n * t / threads; i < n * (t + 1) / threads; ++i)
+                buffer[next[(key(edges[i]) >> shift) & 255]++] = edges[i];
+        });
+        edges.swap(buffer);
+    }
+}
+
+/**
+ * @brief Kruskal's algorithm on packed edges.
+ * @param edges All candidate edges (sorted in place by cost).
+ * @param num_areas Number of interned areas.
+ * @param threads Threads for the radix sort.
+ * @param total_cost Output: cost of the returned tree.
+ * @return The MST (a spanning forest if the graph is disconnected).
+ */
+vector<PackedEdge> kruskal_mst_packed(vector<PackedEdge>& edges, int num_areas, int threads, long long& total_cost) {
+    radix_sort_by_cost(edges, threads);
+    UnionFind uf(num_areas);
+    vector<PackedEdge> mst_edges;
+    total_cost = 0;
+    for (const auto& edge : edges) {
+        if (uf.unite(edge.from, edge.to)) {
+            mst_edges.push_back(edge);
+            total_cost += edge.cost;
+            if ((int)mst_edges.size() == num_areas - 1) break;
+        }
+    }
+    return mst_edges;
+}
+
+// --- 5. Dynamic MST Maintenance ---
+// Answers "what if this road is built / this link closes" without re-running Kruskal.
+// The current forest lives in a link-cut tree where every road is its own node carrying
+// its cost, so the heaviest road on a tree path is a single O(log n) query.
+
+/**
+ * @brief Link-cut tree with a path maximum. Node 0 is the null node.
+ */
+class LinkCutTree {
+private:
+    vector<array<int, 2>> child;
+    vector<int> up;
+    vector<char> flipped;
+    vector<uint64_t> value, path_max;
+
+    bool is_root(int x) const { return child[up[x]][0] != x && child[up[x]][1] != x; }
+
+    void pull(int x) { path_max[x] = max({value[x], path_max[child[x][0]], path_max[child[x][1]]}); }
+
+    void push(int x) {
+        if (!flipped[x]) return;
+        for (int c : child[x]) {
+            if (c) {
+                swap(child[c][0], child[c][1]);
+                flipped[c] ^= 1;
+            }
+        }
+        flipped[x] = 0;
+    }
+
+    void rotate(int x) {
+        int p = up[x], g = up[p];
+        int side = child[p][1] == x;
+        if (!is_root(p)) child[g][child[g][1] == p] = x;
+        up[x] = g;
+        child[p][side] = child[x][side ^ 1];
+        up[child[x][side ^ 1]] = p;
+        child[x][side ^ 1] = p;
+        up[p] = x;
+        pull(p);
+        pull(x);
+    }
+
+    void splay(int x) {
+        static vector<int> stack;
+        stack.assign(1, x);
+        for (int y = x; !is_root(y); y = up[y]) stack.push_back(up[y]);
+        while (!stack.empty()) {
+            push(stack.back());
+            stack.pop_back();
+        }
+        while (!is_root(x)) {
+            int p = up[x], g = up[p];
+            if (!is_root(p)) rotate((child[g][1] == p) == (child[p][1] == x) ? p : x);
+            rotate(x);
+        }
+    }
+
+    void access(int x) {
+        for (int last = 0; x; last = x, x = up[x]) {
+            splay(x);
+            child[x][1] = last;
+            pull(x);
+        }
+    }
+
+    void make_root(int x) {
+        access(x);
+        splay(x);
+        swap(child[x][0], child[x][1]);
+        flipped[x] ^= 1;
+    }
+
+    int find_root(int x) {
+        access(x);
+        splay(x);
+        while (child[x][0]) {
+            push(x);
+            x = child[x][0];
+        }
+        splay(x);
+        return x;
+    }
+
+public:
+    LinkCutTree() : child(1, {0, 0}), up(1, 0), flipped(1, 0), value(1, 0), path_max(1, 0) {}
+
+    int add_node(uint64_t key) {
+        child.push_back({0, 0});
+        up.push_back(0);
+        flipped.push_back(0);
+        value.push_back(key);
+        path_max.push_back(key);
+        return (int)value.size() - 1;
+    }
+
+    bool connected(int x, int y) { return x == y || find_root(x) == find_root(y); }
+
+    void link(int x, int y) {
+        make_root(x);
+        up[x] = y;
+    }
+
+    void cut(int x, int y) {
+        make_root(x);
+        access(y);
+        splay(y);
+        child[y][0] = up[x] = 0;
+        pull(y);
+    }
+
+    // Largest key on the tree path between x and y (they must be connected).
+    uint64_t max_on_path(int x, int y) {
+        make_root(x);
+        access(y);
+        splay(y);
+        return path_max[y];
+    }
+};
+
+/**
+ * @brief Minimum spanning forest under road additions and closures.
+ *
+ * - add_road: if the endpoints are already connected, the new road replaces the heaviest road
+ *   on the tree path between them when it is cheaper; O(log n) amortized.
+ * - close_road on a spare (non-tree) road only unlists it. Closing a tree road cuts the
+ *   forest and races two searches for the cheapest spare road across the cut:
+ *   - the smaller side (both sides explored in lock-step), then its spare roads;
+ *   - all spare roads in cost order, stopping at the first whose ends are no longer
+ *     connected (every spare road joins two areas of one tree, so only crossing roads are).
+ *   The cost is the smaller of the two: small cuts end on the first, large cuts with a cheap
+ *   crossing road on the second. Only a large cut whose cheapest crossing road is among the
+ *   most expensive spares is still linear in the smaller side.
+ *
+ * Equal costs are ordered by road ID, so the forest is always the unique minimum one.
+ */
+class DynamicMst {
+private:
+    struct Road {
+        PackedEdge edge;
+        int node;                  // Link-cut tree node
+        bool open = true;
+        bool in_tree = false;
+        int slot[2] = {-1, -1};    // Position in the endpoints' tree/spare lists
+    };
+
+    LinkCutTree forest;
+    vector<int> area_node;
+    vector<Road> roads;
+    vector<vector<int>> tree_roads, spare_roads;   // Per area
+    set<uint64_t> spare_by_key;                    // Every listed spare road, cheapest first
+    vector<int> seen;                              // Stamps for the cut search
+    int stamp = 0;
+
+    // Resumable search of the smaller side of a cut, then of its spare roads.
+    struct CutScan {
+        vector<int> side[2];
+        size_t head[2] = {0, 0};
+        int turn = 0;
+        int done = -1;              // The side whose search finished first
+        size_t area = 0, road = 0;  // Position in the finished side's spare lists
+        int best = -1;
+    };
+    long long cost = 0;
+    int tree_size = 0;
+
+    static uint64_t key(const PackedEdge& e, int id) {
+        return (uint64_t)((uint32_t)e.cost ^ 0x80000000u) << 32 | (uint32_t)id;
+    }
+
+    int other_end(int id, int area) const {
+        return (int)roads[id].edge.from == area ? roads[id].edge.to : roads[id].edge.from;
+    }
+
+    // Self-loops are never listed: they can neither join the forest nor replace a road in it.
+    void list_road(int id) {
+        Road& r = roads[id];
+        if (r.edge.from == r.edge.to) return;
+        int ends[2] = {(int)r.edge.from, (int)r.edge.to};
+        for (int k = 0; k < 2; ++k) {
+            auto& list = (r.in_tree ? tree_roads : spare_roads)[ends[k]];
+            r.slot[k] = (int)list.size();
+            list.push_back(id);
+        }
+        if (!r.in_tree) spare_by_key.insert(key(r.edge, id));
+    }
+
+    void unlist_road(int id) {
+        Road& r = roads[id];
+        if (r.slot[0] < 0) return;
+        if (!r.in_tree) spare_by_key.erase(key(r.edge, id));
+        int ends[2] = {(int)r.edge.from, (int)r.edge.to};
+        for (int k = 0; k < 2; ++k) {
+            auto& list = (r.in_tree ? tree_roads : spare_roads)[ends[k]];
+            int moved = list.back();
+            list[r.slot[k]] = moved;
+            list.pop_back();
+            if (moved != id) roads[moved].slot[(int)roads[moved].edge.from == ends[k] ? 0 : 1] = r.slot[k];
+            r.slot[k] = -1;
+        }
+    }
+
+    void attach(int id) {
+        Road& r = roads[id];
+        forest.link(area_node[r.edge.from], r.node);
+        forest.link(r.node, area_node[r.edge.to]);
+        r.in_tree = true;
+        list_road(id);
+        cost += r.edge.cost;
+        tree_size++;
+    }
+
+    void detach(int id) {
+        Road& r = roads[id];
+        forest.cut(area_node[r.edge.from], r.node);
+        forest.cut(r.node, area_node[r.edge.to]);
+        unlist_road(id);
+        r.in_tree = false;
+        cost -= r.edge.cost;
+        tree_size--;
+    }
+
+    // One unit of work on a cut between the trees containing c.side[0][0] and c.side[1][0]:
+    // an area of the lock-step search, or one spare road of the smaller side once that side
+    // is known. Returns true when c.best holds the cheapest road across the cut (or -1).
+    bool cut_step(CutScan& c) {
+        if (c.done < 0) {
+            int s = c.turn;
+            c.turn ^= 1;
+            if (c.head[s] == c.side[s].size()) {
+                c.done = s;
+                return false;
+            }
+            int x = c.side[s][c.head[s]++];
+            for (int id : tree_roads[x]) {
+                int y = other_end(id, x);
+                if (seen[y] != stamp + s) {
+                    seen[y] = stamp + s;
+                    c.side[s].push_back(y);
+                }
+            }
+            return false;
+        }
+        const vector<int>& side = c.side[c.done];
+        while (c.area < side.size() && c.road == spare_roads[side[c.area]].size()) {
+            c.area++;
+            c.road = 0;
+        }
+        if (c.area == side.size()) return true;
+        int x = side[c.area], s = spare_roads[x][c.road++];
+        if (seen[other_end(s, x)] != stamp + c.done && (c.best < 0 || key(roads[s].edge, s) < key(roads[c.best].edge, c.best)))
+            c.best = s;
+        return false;
+    }
+
+public:
+    /**
+     * @brief Builds the initial forest with Kruskal's algorithm.
+     * @param num_areas Number of interned areas.
+     * @param edges Candidate roads; road i keeps ID i.
+     */
+    DynamicMst(int num_areas, const vector<PackedEdge>& edges) {
+        for (int a = 0; a < num_areas; ++a) add_area();
+        vector<int> order(edges.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int x, int y) { return key(edges[x], x) < key(edges[y], y); });
+        for (size_t i = 0; i < edges.size(); ++i) {
+            roads.push_back({edges[i], forest.add_node(key(edges[i], (int)i))});
+        }
+        UnionFind uf(num_areas);
+        for (int id : order) {
+            if (uf.unite(edges[id].from, edges[id].to)) attach(id);
+            else list_road(id);
+        }
+    }
+
+    int add_area() {
+        area_node.push_back(forest.add_node(0));
+        tree_roads.emplace_back();
+        spare_roads.emplace_back();
+        seen.push_back(0);
+        return (int)area_node.size() - 1;
+    }
+
+    /**
+     * @brief Proposes a new road.
+     * @return Its road ID.
+     */
+    int add_road(int from, int to, int cost_in_crores) {
+        int id = (int)roads.size();
+        PackedEdge e{(uint32_t)from, (uint32_t)to, cost_in_crores};
+        roads.push_back({e, forest.add_node(key(e, id))});
+        int u = area_node[from], v = area_node[to];
+        if (from == to) {
+            list_road(id);
+        } else if (!forest.connected(u, v)) {
+            attach(id);
+        } else {
+            uint64_t heaviest = forest.max_on_path(u, v);
+            if (key(e, id) < heaviest) {
+                detach((int)(uint32_t)heaviest);
+                list_road((int)(uint32_t)heaviest);
+                attach(id);
+            } else {
+                list_road(id);
+            }
+        }
+        return id;
+    }
+
+    /**
+     * @brief Marks a road unusable and repairs the forest.
+     */
+    void close_road(int id) {
+        Road& r = roads[id];
+        if (!r.open) return;
+        r.open = false;
+        if (!r.in_tree) {
+            unlist_road(id);
+            return;
+        }
+        detach(id);
+
+        // A connectivity check (a few splay operations) costs roughly as much as this many
+        // local steps; 4 and 64 both measured slower in dynamic-bench.
+        const int LOCAL_STEPS_PER_CHECK = 16;
+        stamp += 2;
+        CutScan cut;
+        cut.side[0] = {(int)r.edge.from};
+        cut.side[1] = {(int)r.edge.to};
+        seen[r.edge.from] = stamp;
+        seen[r.edge.to] = stamp + 1;
+        auto next_spare = spare_by_key.begin();
+        int best = -1;
+        while (true) {
+            if (next_spare == spare_by_key.end()) break; // No spare road crosses the cut
+            const PackedEdge& e = roads[(uint32_t)*next_spare].edge;
+            if (!forest.connected(area_node[e.from], area_node[e.to])) {
+                best = (int)(uint32_t)*next_spare;
+                break;
+            }
+            ++next_spare;
+            bool done = false;
+            for (int k = 0; k < LOCAL_STEPS_PER_CHECK && !done; ++k) done = cut_step(cut);
+            if (done) {
+                best = cut.best;
+                break;
+            }
+        }
+        if (best >= 0) {
+            unlist_road(best);
+            attach(best);
+        }
+    }
+
+    long long total_cost() const { return cost; }
+    int tree_edges() const { return tree_size; }
+    int area_count() const { return (int)area_node.size(); }
+    int road_count() const { return (int)roads.size(); }
+    bool is_open(int id) const { return roads[id].open; }
+    bool in_tree(int id) const { return roads[id].in_tree; }
+    const PackedEdge& road(int id) const { return roads[id].edge; }
+
+    vector<PackedEdge> tree() const {
+        vector<PackedEdge> result;
+        for (const auto& r : roads)
+            if (r.in_tree) result.push_back(r.edge);
+        return result;
+    }
+};
+
+
+double ms_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Generates a random connected road network as dataset text and times the string
+ * path (parse_data + kruskal_mst) against the integer-ID path on the same text.
+ * @param num_areas Number of areas.
+ * @param num_edges Number of candidate edges.
+ */
+int run_benchmark(int num_areas, long long num_edges) {
+    int threads = max(1u, thread::hardware_concurrency());
+    mt19937 rng(21);
+    string dataset = "area_from area_to cost_in_crores\n";
+    dataset.reserve((size_t)num_edges * 32);
+    auto area = [](int id) { return "Area_" + to_string(id); };
+    for (long long i = 0; i < num_edges; ++i) {
+        // The first num_areas - 1 edges form a random spanning tree, so the network is connected.
+        int u = i < num_areas - 1 ? (int)i + 1 : (int)(rng() % num_areas);
+        int v = i < num_areas - 1 ? (int)(rng() % (i + 1)) : (int)(rng() % num_areas);
+        dataset += area(u) + ' ' + area(v) + ' ' + to_string(1 + rng() % 100000) + '\n';
+    }
+    printf("%d areas, %lld candidate edges (%.0f MB of text), %d thread(s)\n\n", num_areas, num_edges,
+           dataset.size() / 1e6, threads);
+    printf("%-28s %12s %12s %12s\n", "path", "parse ms", "MST ms", "total ms");
+
+    long long string_cost = 0;
+    size_t string_count;
+    double string_parse, string_mst;
+    {
+        vector<Edge> edges;
+        map<string, int> areas;
+        auto t0 = chrono::steady_clock::now();
+        parse_data(dataset, edges, areas);
+        string_parse = ms_since(t0);
+        t0 = chrono::steady_clock::now();
+        streambuf* saved = cout.rdbuf(nullptr); // kruskal_mst reports to cout
+        vector<Edge> mst = kruskal_mst(edges, areas);
+        cout.rdbuf(saved);
+        string_mst = ms_since(t0);
+        string_count = mst.size();
+        for (auto& e : mst) string_cost += e.cost;
+    }
+    printf("%-28s %12.0f %12.0f %12.0f\n", "strings + map + std::sort", string_parse, string_mst,
+           string_parse + string_mst);
+
+    vector<PackedEdge> edges;
+    edges.reserve(num_edges);
+    AreaIndex areas;
+    auto t0 = chrono::steady_clock::now();
+    parse_edges(dataset, edges, areas);
+    double packed_parse = ms_since(t0);
+    long long packed_cost;
+    t0 = chrono::steady_clock::now();
+    vector<PackedEdge> mst = kruskal_mst_packed(edges, areas.size(), threads, packed_cost);
+    double packed_mst = ms_since(t0);
+    printf("%-28s %12.0f %12.0f %12.0f\n", "interned IDs + radix sort", packed_parse, packed_mst,
+           packed_parse + packed_mst);
+
+    int mismatches = (packed_cost != string_cost) + (mst.size() != string_count);
+    printf("\nMST cost %lld over %zu edges; %d mismatch(es) between the paths\n", packed_cost, mst.size(), mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+
+/**
+ * @brief What-if session on top of the computed network. Reads commands from stdin:
+ *     add <Area_From> <Area_To> <cost>     propose a new road
+ *     close <Area_From> <Area_To>          mark an existing road unusable
+ * and reports the new minimum construction cost after each one.
+ */
+void run_planner(const vector<PackedEdge>& edges, AreaIndex& areas) {
+    DynamicMst live(areas.size(), edges);
+    unordered_multimap<uint64_t, int> road_ids;   // Unordered area pair -> road IDs
+    auto pair_key = [](uint32_t a, uint32_t b) { return (uint64_t)min(a, b) << 32 | max(a, b); };
+    for (int id = 0; id < live.road_count(); ++id) road_ids.emplace(pair_key(live.road(id).from, live.road(id).to), id);
+
+    cout << "\n--- What-If Planner (add <from> <to> <cost> | close <from> <to>) ---\n";
+    string command, from, to;
+    while (cin >> command >> from >> to) {
+        long long before = live.total_cost();
+        if (command == "add") {
+            int cost;
+            if (!(cin >> cost)) break;
+            int u = areas.intern(from), v = areas.intern(to);
+            while (live.area_count() < areas.size()) live.add_area();
+            road_ids.emplace(pair_key(u, v), live.add_road(u, v, cost));
+        } else if (command == "close") {
+            int u = areas.find(from), v = areas.find(to), id = -1;
+            if (u >= 0 && v >= 0) {
+                auto range = road_ids.equal_range(pair_key(u, v));
+                for (auto it = range.first; it != range.second && id < 0; ++it)
+                    if (live.is_open(it->second)) id = it->second;
+            }
+            if (id < 0) {
+                cout << "No open road between " << from << " and " << to << "\n";
+                continue;
+            }
+            live.close_road(id);
+        } else {
+            cout << "Unknown command: " << command << "\n";
+            continue;
+        }
+        cout << "Total Minimum Construction Cost: " << live.total_cost() << " Crores (change: "
+             << showpos << live.total_cost() - before << noshowpos << ")\n";
+    }
+}
+
+/**
+ * @brief Replays random road additions and closures against DynamicMst and checks the
+ * forest cost against a full Kruskal recomputation at regular checkpoints.
+ * @param num_areas Number of areas.
+ * @param num_edges Number of initial candidate roads.
+ * @param num_ops Number of updates to replay.
+ */
+int run_dynamic_benchmark(int num_areas, int num_edges, int num_ops) {
+    mt19937 rng(23);
+    auto random_road = [&]() {
+        return PackedEdge{(uint32_t)(rng() % num_areas), (uint32_t)(rng() % num_areas), (int32_t)(1 + rng() % 100000)};
+    };
+    vector<PackedEdge> edges;
+    for (int i = 0; i < num_edges; ++i) edges.push_back(random_road());
+
+    auto t0 = chrono::steady_clock::now();
+    DynamicMst live(num_areas, edges);
+    printf("%d areas, %d candidate roads, %d updates; initial build %.0f ms\n\n", num_areas, num_edges, num_ops,
+           ms_since(t0));
+
+    // Recomputes the forest from scratch over the open roads.
+    auto recompute = [&](double& ms) {
+        vector<PackedEdge> open_roads;
+        for (int id = 0; id < live.road_count(); ++id)
+            if (live.is_open(id)) open_roads.push_back(live.road(id));
+        long long total;
+        auto start = chrono::steady_clock::now();
+        kruskal_mst_packed(open_roads, num_areas, 1, total);
+        ms = ms_since(start);
+        return total;
+    };
+
+    const char* kinds[3] = {"add road", "close spare road", "close tree road"};
+    vector<double> times_us[3];
+    int mismatches = 0, checks = 0;
+    double recompute_ms = 0;
+    vector<int> open_ids(live.road_count());
+    iota(open_ids.begin(), open_ids.end(), 0);
+
+    for (int op = 1; op <= num_ops; ++op) {
+        int kind;
+        auto start = chrono::steady_clock::now();
+        if (rng() % 2 == 0 || open_ids.empty()) {
+            PackedEdge e = random_road();
+            open_ids.push_back(live.add_road(e.from, e.to, e.cost));
+            kind = 0;
+        } else {
+            size_t pick = rng() % open_ids.size();
+            int id = open_ids[pick];
+            open_ids[pick] = open_ids.back();
+            open_ids.pop_back();
+            kind = live.in_tree(id) ? 2 : 1;
+            live.close_road(id);
+        }
+        times_us[kind].push_back(ms_since(start) * 1000);
+
+        if (op % max(1, num_ops / 10) == 0) {
+            double ms;
+            checks++;
+            mismatches += recompute(ms) != live.total_cost();
+            recompute_ms += ms;
+        }
+    }
+
+    printf("%-20s %10s %14s %14s %14s\n", "update", "count", "mean (us)", "p99 (us)", "worst (us)");
+    for (int k = 0; k < 3; ++k) {
+        vector<double>& t = times_us[k];
+        sort(t.begin(), t.end());
+        double mean = t.empty() ? 0.0 : accumulate(t.begin(), t.end(), 0.0) / t.size();
+        printf("%-20s %10zu %14.2f %14.1f %14.1f\n", kinds[k], t.size(), mean, t.empty() ? 0.0 : t[t.size() * 99 / 100],
+               t.empty() ? 0.0 : t.back());
+    }
+    printf("%-20s %10d %14.2f\n", "full recompute", checks, checks ? recompute_ms * 1000 / checks : 0.0);
+    printf("\nFinal forest cost %lld over %d roads; %d of %d checkpoint(s) differ from recomputation\n",
+           live.total_cost(), live.tree_edges(), mismatches, checks);
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        return run_benchmark(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoll(argv[3]) : 10000000);
+    }
+    if (argc > 1 && string(argv[1]) == "dynamic-bench") {
+        return run_dynamic_benchmark(argc > 2 ? atoi(argv[2]) : 100000, argc > 3 ? atoi(argv[3]) : 1000000,
+                                     argc > 4 ? atoi(argv[4]) : 200000);
+    }
+    bool plan_mode = argc > 1 && string(argv[1]) == "plan";
+    const char* dataset_path = argc > 1 + plan_mode ? argv[1 + plan_mode] : nullptr;
+
     // Dataset provided by the user (using underscores for areas with spaces for simple parsing)
     const string dataset = 
         "area_from area_to cost_in_crores\n"
@@ -188,23 +930,43 @@ int main() {
         "Commercial_Hub Industrial_Area 7\n"
         "Commercial_Hub Airport 16\n";
 
-    vector<Edge> all_potential_roads;
-    map<string, int> area_to_id;
+    string file_data;
+    if (dataset_path) {
+        ifstream in(dataset_path, ios::binary);
+        if (!in) {
+            cerr << "Could not read " << dataset_path << "\n";
+            return 1;
+        }
+        file_data.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+
+    vector<PackedEdge> all_potential_roads;
+    AreaIndex areas;
 
-    // 1. Parse Data and identify all unique areas (nodes)
-    parse_data(dataset, all_potential_roads, area_to_id);
+    // 1. Parse Data and intern all unique areas (nodes) to integer IDs
+    parse_edges(dataset_path ? string_view(file_data) : string_view(dataset), all_potential_roads, areas);
 
     // 2. Run Kruskal's Algorithm
-    vector<Edge> mst_roads = kruskal_mst(all_potential_roads, area_to_id);
+    long long total_cost;
+    vector<PackedEdge> mst_roads = kruskal_mst_packed(all_potential_roads, areas.size(), 1, total_cost);
+    if ((int)mst_roads.size() != areas.size() - 1 && areas.size() > 0) {
+        cout << "\nWarning: The graph is disconnected. MST could not connect all " << areas.size() << " areas.\n";
+    }
+    cout << "\n--- Kruskal's MST Result ---\n";
+    cout << "Total Minimum Construction Cost: " << total_cost << " Crores\n";
+    cout << "--------------------------------\n";
 
     // 3. Report the selected roads (The new network design)
     cout << "\n--- Recommended Road Network Edges ---\n";
     cout << "To Achieve Minimum Cost:\n";
     for (const auto& edge : mst_roads) {
-        cout << "- Connect **" << edge.from << "** to **" << edge.to 
+        cout << "- Connect **" << areas.name(edge.from) << "** to **" << areas.name(edge.to) 
              << "** (Cost: " << edge.cost << " Cr)\n";
     }
     cout << "------------------------------------\n";
 
+    // 4. Optional what-if session on road additions and closures
+    if (plan_mode) run_planner(all_potential_roads, areas);
+
     return 0;
 }
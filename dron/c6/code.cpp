@@ -1,13 +1,20 @@
 /*
     NOTE:
     The parking dataset used in this program is a sample dataset created 
-    specifically for demonstrating the Min-Heap (for nearest free slot) 
-    and Hash Map (for O(1) occupancy lookup) working together in a 
+    specifically for demonstrating the nearest-free-slot structure (a
+    distance-ranked bitset, originally a Min-Heap) and Hash Map (for O(1) occupancy lookup) working together in a 
     real-time parking management system.
 
     The system is fully scalable — more slots, additional attributes 
     (such as place names, vehicle types, timestamps), or real parking 
     layouts can be added without modifying the core heap and hashing logic.
+
+    Slots are renumbered by distance from the gate when the dataset is loaded, so the
+    nearest free slot is simply the lowest set bit of a hierarchical bitset.
+
+    Usage:
+        ./code                        interactive parking desk on the built-in dataset
+        ./code bench [slots ops]      arrival/exit churn: bitset vs min-heap (default 100k slots, 10M ops)
 */
 
 #include <iostream>
@@ -19,30 +26,94 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
 
 using namespace std;
 
 // --- GLOBAL CONFIGURATION AND DATA STRUCTURES ---
 
-// Min-Heap: Stores the IDs of all currently FREE parking slots (smallest ID = closest).
-priority_queue<int, vector<int>, greater<int>> free_slots_min_heap;
+/**
+ * @brief Set of free slot ranks as a 64-ary bitset hierarchy.
+ *
+ * Level 0 holds one bit per slot; bit j of level k+1 is set when word j of level k is
+ * non-zero. Three levels cover 262,144 slots. The lowest free rank is one ctz per level,
+ * and taking or releasing a slot only touches the levels whose word changes emptiness.
+ */
+class FreeSlotBitset {
+private:
+    vector<vector<uint64_t>> levels;
+    int free_count = 0;
+
+public:
+    void reset(int num_slots) {
+        levels.clear();
+        size_t words = num_slots;
+        do {
+            words = (words + 63) / 64;
+            levels.emplace_back(max<size_t>(words, 1), 0);
+        } while (words > 1);
+        free_count = 0;
+    }
 
-// Hash Map: Tracks OCCUPIED slots: Key=Vehicle ID, Value=Slot ID. (O(1) lookup)
-unordered_map<string, int> occupancy_map;
+    void release(int rank) {
+        free_count++;
+        for (auto& level : levels) {
+            uint64_t& word = level[rank >> 6];
+            bool was_empty = word == 0;
+            word |= 1ull << (rank & 63);
+            if (!was_empty) break;
+            rank >>= 6;
+        }
+    }
+
+    void take(int rank) {
+        free_count--;
+        for (auto& level : levels) {
+            uint64_t& word = level[rank >> 6];
+            word &= ~(1ull << (rank & 63));
+            if (word != 0) break;
+            rank >>= 6;
+        }
+    }
+
+    // Lowest free rank (the slot nearest the gate), or -1 if every slot is taken.
+    int nearest() const {
+        if (levels.back()[0] == 0) return -1;
+        int rank = 0;
+        for (int k = (int)levels.size() - 1; k >= 0; --k)
+            rank = (rank << 6) | __builtin_ctzll(levels[k][rank]);
+        return rank;
+    }
+
+    int size() const { return free_count; }
+    bool empty() const { return free_count == 0; }
+};
 
-// Map to store initial slot data (Now simplified as place_name is removed)
+// Slot info, stored densely by rank: rank 0 is the slot closest to the gate (ties by slot ID).
 struct SlotInfo {
+    int slot_id;
     int distance;
     bool is_occupied;
     string vehicle_id;
 };
-unordered_map<int, SlotInfo> parking_lot_info;
+vector<SlotInfo> parking_lot_info;
+
+// Bitset: ranks of all currently FREE parking slots.
+FreeSlotBitset free_slots;
+
+// Hash Map: Tracks OCCUPIED slots: Key=Vehicle ID, Value=Slot rank. (O(1) lookup)
+unordered_map<string, int> occupancy_map;
 
 
 /**
  * @brief Parses the raw dataset and initializes the system state.
  *
  * NOTE: The dataset format is now: slot_id distance_from_gate occupied vehicle_id (if occupied).
+ * Slots are then ranked by distance from the gate (ties by slot ID) and stored by rank.
  */
 void initialize_system(const string& raw_data) {
     stringstream ss(raw_data);
@@ -53,6 +124,8 @@ void initialize_system(const string& raw_data) {
     int occupied_int;
     string vehicle_id;
 
+    parking_lot_info.clear();
+    occupancy_map.clear();
     while (ss >> slot_id >> distance >> occupied_int) {
         
         vehicle_id = ""; // Reset vehicle ID for each slot
@@ -66,18 +139,27 @@ void initialize_system(const string& raw_data) {
         }
 
         // Store initial slot information
-        parking_lot_info[slot_id] = {
+        parking_lot_info.push_back({
+            slot_id,
             distance, 
             (occupied_int == 1), 
             vehicle_id
-        };
+        });
+    }
 
-        if (occupied_int == 0) {
-            // Add free slots to the Min-Heap
-            free_slots_min_heap.push(slot_id);
-        } else if (occupied_int == 1) {
+    // Renumber slots by distance: rank order is nearest-first order
+    sort(parking_lot_info.begin(), parking_lot_info.end(), [](const SlotInfo& a, const SlotInfo& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.slot_id < b.slot_id;
+    });
+
+    free_slots.reset(parking_lot_info.size());
+    for (int rank = 0; rank < (int)parking_lot_info.size(); ++rank) {
+        if (!parking_lot_info[rank].is_occupied) {
+            // Add free slots to the bitset
+            free_slots.release(rank);
+        } else {
             // Add occupied slots to the Hash Map
-            occupancy_map[vehicle_id] = slot_id;
+            occupancy_map[parking_lot_info[rank].vehicle_id] = rank;
         }
     }
 }
@@ -93,14 +175,14 @@ void display_menu() {
     cout << "2. Vehicle Exit (Make slot empty)\n";
     cout << "3. Exit Program\n";
     cout << "-------------------------------------------------\n";
-    cout << "System Status: Free Slots: " << free_slots_min_heap.size() 
+    cout << "System Status: Free Slots: " << free_slots.size() 
          << " | Occupied: " << occupancy_map.size() << "\n";
     
-    if (!free_slots_min_heap.empty()) {
-        int closest_slot_id = free_slots_min_heap.top();
+    if (!free_slots.empty()) {
+        const SlotInfo& closest = parking_lot_info[free_slots.nearest()];
         // Distance is used here for context since place_name is missing
-        cout << "NEXT UP: Closest Available Slot is " << closest_slot_id 
-             << " (Distance: " << parking_lot_info[closest_slot_id].distance << " units)\n";
+        cout << "NEXT UP: Closest Available Slot is " << closest.slot_id 
+             << " (Distance: " << closest.distance << " units)\n";
     } else {
         cout << "Parking lot is FULL.\n";
     }
@@ -117,18 +199,18 @@ void handle_arrival() {
 
     if (occupancy_map.count(vehicle_id)) {
         cout << "[ERROR] Vehicle " << vehicle_id << " is already parked in Slot " 
-             << occupancy_map[vehicle_id] << ".\n";
+             << parking_lot_info[occupancy_map[vehicle_id]].slot_id << ".\n";
         return;
     }
 
-    if (free_slots_min_heap.empty()) {
+    if (free_slots.empty()) {
         cout << "[SYSTEM] ERROR: Parking lot is full. Cannot assign slot to " << vehicle_id << ".\n";
         return;
     }
 
-    // Min-Heap (Greedy): Get the closest available slot (O(log N))
-    int assigned_slot = free_slots_min_heap.top();
-    free_slots_min_heap.pop(); 
+    // Bitset (Greedy): Get the closest available slot (one ctz per level)
+    int assigned_slot = free_slots.nearest();
+    free_slots.take(assigned_slot);
     int distance = parking_lot_info[assigned_slot].distance;
 
     // Hash Map: Record the assignment (O(1) average)
@@ -138,7 +220,7 @@ void handle_arrival() {
     parking_lot_info[assigned_slot].is_occupied = true;
     parking_lot_info[assigned_slot].vehicle_id = vehicle_id;
 
-    cout << "\n[SUCCESS] Vehicle **" << vehicle_id << "** assigned to **Slot " << assigned_slot 
+    cout << "\n[SUCCESS] Vehicle **" << vehicle_id << "** assigned to **Slot " << parking_lot_info[assigned_slot].slot_id 
          << "** (Distance: " << distance << " units).\n";
 }
 
@@ -163,19 +245,80 @@ void handle_exit() {
     // Hash Map: Remove the occupancy record (O(1) average)
     occupancy_map.erase(it); 
 
-    // Min-Heap: Restore slot availability (O(log N))
-    free_slots_min_heap.push(released_slot); 
+    // Bitset: Restore slot availability (a single bit set in the common case)
+    free_slots.release(released_slot); 
 
     // Update slot info
     parking_lot_info[released_slot].is_occupied = false;
     parking_lot_info[released_slot].vehicle_id = "";
     
-    cout << "\n[SUCCESS] Vehicle **" << vehicle_id << "** released **Slot " << released_slot 
+    cout << "\n[SUCCESS] Vehicle **" << vehicle_id << "** released **Slot " << parking_lot_info[released_slot].slot_id 
          << "** (Distance: " << parking_lot_info[released_slot].distance << " units). Slot is now FREE.\n";
 }
 
 
-int main() {
+double ms_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Replays the same random arrival/exit sequence against a min-heap of free ranks and
+ * against FreeSlotBitset, and checks that both hand out the same slots.
+ * @param num_slots Number of slots in the garage (half start occupied).
+ * @param num_ops Number of arrivals and exits.
+ */
+int run_benchmark(int num_slots, long long num_ops) {
+    auto churn = [&](auto take_nearest, auto release, long long& checksum) {
+        mt19937 rng(25);
+        vector<int> parked;
+        for (int rank = 0; rank < num_slots; rank += 2) parked.push_back(rank);
+        int free_count = num_slots - (int)parked.size();
+        checksum = 0;
+        auto t0 = chrono::steady_clock::now();
+        for (long long op = 0; op < num_ops; ++op) {
+            if ((rng() & 1) && free_count > 0) {
+                int rank = take_nearest();
+                parked.push_back(rank);
+                free_count--;
+                checksum += rank;
+            } else if (!parked.empty()) {
+                size_t pick = rng() % parked.size();
+                release(parked[pick]);
+                parked[pick] = parked.back();
+                parked.pop_back();
+                free_count++;
+            }
+        }
+        return ms_since(t0);
+    };
+
+    priority_queue<int, vector<int>, greater<int>> heap;
+    for (int rank = 1; rank < num_slots; rank += 2) heap.push(rank);
+    long long heap_sum;
+    double heap_ms = churn([&]() { int rank = heap.top(); heap.pop(); return rank; },
+                           [&](int rank) { heap.push(rank); }, heap_sum);
+
+    FreeSlotBitset bits;
+    bits.reset(num_slots);
+    for (int rank = 1; rank < num_slots; rank += 2) bits.release(rank);
+    long long bits_sum;
+    double bits_ms = churn([&]() { int rank = bits.nearest(); bits.take(rank); return rank; },
+                           [&](int rank) { bits.release(rank); }, bits_sum);
+
+    printf("%d slots, %lld arrivals/exits\n\n", num_slots, num_ops);
+    printf("%-22s %12s %14s\n", "free-slot structure", "time (ms)", "ns per op");
+    printf("%-22s %12.1f %14.1f\n", "min-heap", heap_ms, heap_ms * 1e6 / num_ops);
+    printf("%-22s %12.1f %14.1f\n", "bitset hierarchy", bits_ms, bits_ms * 1e6 / num_ops);
+    printf("\nAssignments %s\n", heap_sum == bits_sum ? "match" : "DIFFER");
+    return heap_sum == bits_sum ? 0 : 1;
+}
+
+
+int main(int argc, char** argv) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        return run_benchmark(argc > 2 ? atoi(argv[2]) : 100000, argc > 3 ? atoll(argv[3]) : 10000000);
+    }
+
     // New Dataset provided by the user (without place_name)
     const string dataset = 
         "slot_id distance_from_gate occupied vehicle_id\n"